@@ -25,6 +25,49 @@ extern int brain_x;
  */
 extern int brain_y;
 
+/*-----------------------------------------------------------------------------
+ * CALLBACK TYPES
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Button press handler, receives the index of the pressed button
+ * @note Accepts plain functions as well as capturing lambdas (see callback.h)
+ */
+typedef Callback<void(int)> ActionCallback;
+
+/**
+ * @brief Renders an interface on the Brain screen
+ */
+typedef Callback<void()> DisplayCallback;
+
+/**
+ * @brief Background update hook, called repeatedly while an interface is active
+ */
+typedef Callback<int()> UpdateCallback;
+
+/*-----------------------------------------------------------------------------
+ * INTERFACE STATES
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Lifecycle states stored in Interface::index
+ *
+ * Any value >= 0 is the "pressed" state and holds the index of the button
+ * that was pressed. Transitions between states are made with atomic
+ * compare-and-swap, so the update task and the main loop always agree on
+ * which interface owns the screen.
+ *
+ *   INACTIVE --setIndex/navigation--> ACTIVE --touch--> PRESSED(n)
+ *   PRESSED(n) --action only--> ACTIVE
+ *   PRESSED(n) --linked--> TRANSITIONING --> INACTIVE
+ */
+enum InterfaceState
+{
+    ITF_TRANSITIONING = -3,   // Navigating away, update task must stop drawing
+    ITF_INACTIVE      = -2,   // Not displayed
+    ITF_ACTIVE        = -1    // Displayed, waiting for input
+};
+
 /*  To convert the drawing of an Interface into code, please go to
     VEX Image Converter: https://suhjae.github.io/vex-image/  */
 
@@ -57,11 +100,14 @@ class Interface
          * @brief Interface state tracker
          *
          * Values:
+         *  -3 = Transitioning (navigation in progress)
          *  -2 = Inactive (interface not displayed)
          *  -1 = Active (interface displayed, waiting for input)
          * >=0 = Button index that was pressed
+         *
+         * @note Atomic: read by the update task, written by the main loop
          */
-        int index;
+        std::atomic<int> index;
 
         /**
          * @brief Pointer to button coordinate definitions
@@ -84,33 +130,34 @@ class Interface
         std::vector<Interface*>* linked_Interface;
 
         /**
-         * @brief Function pointer for action callbacks
+         * @brief Callback for button press actions
          *
          * Called when a button is pressed. The button index is passed
          * as a parameter, allowing custom handling for each button.
+         * May capture its own state (no heap allocation is involved).
          *
          * @param buttonIndex The index of the button that was pressed
          */
-        void (*actions)(int);
+        ActionCallback actions;
 
         /**
-         * @brief Function pointer for rendering the interface
+         * @brief Callback for rendering the interface
          *
          * Called by Display() to draw the interface graphics on the
          * Brain screen. Should contain all drawing code (text, shapes,
          * images, etc.)
          */
-        void (*display)();
+        DisplayCallback display;
 
         /**
-         * @brief Function pointer for background update tasks
+         * @brief Callback for background update tasks
          *
          * Continuously called while interface is active (index == -1).
          * Used for dynamic displays like sensor readings, timers, etc.
          *
          * @return Should return 0 when complete
          */
-        int (*updateInterface)();
+        UpdateCallback updateInterface;
 
         /**
          * @brief Pointer to the background update task
@@ -120,14 +167,115 @@ class Interface
          */
         task* updateItf_Task = nullptr;
 
+        /**
+         * @brief Off-screen copy of the frame drawn by display()
+         *
+         * Only captured when the interface is cacheable (setCacheable()).
+         * Handed to the navigation history when navigating away, so that
+         * coming back can restore the screen with a single blit.
+         */
+        uint32_t* frame = nullptr;
+
+        /**
+         * @brief Whether display() output may be captured as a snapshot
+         */
+        bool cacheable = false;
+
+        /**
+         * @brief Human-readable name used by diagnostics (Perf screen)
+         */
+        const char* name = nullptr;
+
+        /**
+         * @brief Writes the condensed controller version of the interface
+         *
+         * Called with ControllerMirror::setLine()/print() in mind when the
+         * interface is shown and after each update pass, while the
+         * ControllerMirror is running.
+         */
+        DisplayCallback mirror;
+
+        /**
+         * @brief Whether display() is recorded into the shared RenderBuffer
+         */
+        bool buffered = false;
+
+        /**
+         * @brief Time allowed to each display, update and action callback (us)
+         */
+        uint32_t budget = WATCHDOG_DEFAULT_BUDGET;
+
+        /**
+         * @brief Whether repeated update overruns stretch the update period
+         */
+        BudgetPolicy budgetPolicy = BUDGET_REPORT;
+
+        /**
+         * @brief Current update period multiplier (1 unless throttled)
+         */
+        int updateBackoff = 1;
+
+        /**
+         * @brief RenderBuffer shared by buffered interfaces, lazily allocated
+         */
+        static RenderBuffer* renderBuffer;
+
+        /**
+         * @brief Counters of the last buffered Display()
+         */
+        static RenderStats renderStats;
+
         /**
          * @brief Static flag preventing simultaneous interface activations
          *
          * Ensures only one interface responds to touch input at a time.
-         * Set by activate(), cleared by reset().
+         * Claimed by activate() with compare-and-swap, cleared by reset()
+         * when a press is released. Starts claimed, and constructing an
+         * interface leaves it alone: only a new touch can be handled.
          */
-        static int isActive;
+        static std::atomic<int> isActive;
+
+        /**
+         * @brief Atomically move the interface from one state to another
+         *
+         * @param from Expected current state
+         * @param to New state
+         * @return true if the interface was in state `from` and is now in `to`
+         */
+        bool transition(int from, int to);
+
+        /**
+         * @brief Present the interface from a cached snapshot
+         *
+         * Blits the snapshot instead of calling display(), then starts the
+         * update task exactly like Display() would.
+         *
+         * @param snapshot Frame previously captured from this interface
+         */
+        void Restore(uint32_t* snapshot);
+
+        /**
+         * @brief Start the background update task if one is configured
+         */
+        void startUpdateTask();
+
+        /**
+         * @brief Refresh the controller mirror for this interface
+         *
+         * Calls mirror(), or shows the interface name when there is none.
+         * Does nothing unless the ControllerMirror is running.
+         */
+        void showMirror();
     public:
+        /**
+         * @brief Navigation target meaning "go back to the previous screen"
+         *
+         * Put &Interface::Back in a linked_Interface vector to give a button
+         * Back behaviour. The previous screen is restored from the
+         * navigation history, from its cached snapshot when available.
+         */
+        static Interface Back;
+
         /*---------------------------------------------------------------------
          * CONSTRUCTORS
          *-------------------------------------------------------------------*/
@@ -146,9 +294,9 @@ class Interface
          * Creates a static interface that displays graphics but has no
          * interactive elements.
          *
-         * @param display Function to render the interface graphics
+         * @param display Callback to render the interface graphics
          */
-        Interface (void (*display)());
+        Interface (DisplayCallback display);
 
         /**
          * @brief Display with background updates constructor
@@ -156,11 +304,11 @@ class Interface
          * Creates an interface with dynamic content that updates continuously
          * while displayed (e.g., sensor values, timers).
          *
-         * @param display Function to render the interface graphics
-         * @param updateInterface Function for background update tasks
+         * @param display Callback to render the interface graphics
+         * @param updateInterface Callback for background update tasks
          */
-        Interface (void (*display)(),
-                   int (*updateInterface)());
+        Interface (DisplayCallback display,
+                   UpdateCallback updateInterface);
 
         /**
          * @brief Interactive interface with actions constructor
@@ -170,11 +318,11 @@ class Interface
          *
          * @param button_coord Pointer to button coordinate definitions
          * @param actions Callback function for button press handling
-         * @param display Function to render the interface graphics
+         * @param display Callback to render the interface graphics
          */
         Interface (std::vector<std::vector<double>>* button_coord,
-                   void (*actions)(int),
-                   void (*display)());
+                   ActionCallback actions,
+                   DisplayCallback display);
 
         /**
          * @brief Interactive interface with actions and updates constructor
@@ -184,13 +332,13 @@ class Interface
          *
          * @param button_coord Pointer to button coordinate definitions
          * @param actions Callback function for button press handling
-         * @param display Function to render the interface graphics
-         * @param updateInterface Function for background update tasks
+         * @param display Callback to render the interface graphics
+         * @param updateInterface Callback for background update tasks
          */
         Interface (std::vector<std::vector<double>>* button_coord,
-                   void (*actions)(int),
-                   void (*display)(),
-                   int (*updateInterface)());
+                   ActionCallback actions,
+                   DisplayCallback display,
+                   UpdateCallback updateInterface);
 
         /**
          * @brief Navigation interface constructor
@@ -200,11 +348,11 @@ class Interface
          *
          * @param button_coord Pointer to button coordinate definitions
          * @param linked_Interface Pointer to vector of child interface pointers
-         * @param display Function to render the interface graphics
+         * @param display Callback to render the interface graphics
          */
         Interface (std::vector<std::vector<double>>* button_coord,
                    std::vector<Interface*>* linked_Interface,
-                   void (*display)());
+                   DisplayCallback display);
 
         /**
          * @brief Navigation interface with actions constructor
@@ -215,12 +363,12 @@ class Interface
          * @param button_coord Pointer to button coordinate definitions
          * @param linked_Interface Pointer to vector of child interface pointers
          * @param actions Callback function for button press handling
-         * @param display Function to render the interface graphics
+         * @param display Callback to render the interface graphics
          */
         Interface (std::vector<std::vector<double>>* button_coord,
                    std::vector<Interface*>* linked_Interface,
-                   void (*actions)(int),
-                   void (*display)());
+                   ActionCallback actions,
+                   DisplayCallback display);
 
         /**
          * @brief Navigation interface with updates constructor
@@ -230,13 +378,13 @@ class Interface
          *
          * @param button_coord Pointer to button coordinate definitions
          * @param linked_Interface Pointer to vector of child interface pointers
-         * @param display Function to render the interface graphics
-         * @param updateInterface Function for background update tasks
+         * @param display Callback to render the interface graphics
+         * @param updateInterface Callback for background update tasks
          */
         Interface (std::vector<std::vector<double>>* button_coord,
                    std::vector<Interface*>* linked_Interface,
-                   void (*display)(),
-                   int (*updateInterface)());
+                   DisplayCallback display,
+                   UpdateCallback updateInterface);
 
         /**
          * @brief Full-featured constructor (all features enabled)
@@ -247,14 +395,36 @@ class Interface
          * @param button_coord Pointer to button coordinate definitions
          * @param linked_Interface Pointer to vector of child interface pointers
          * @param actions Callback function for button press handling
-         * @param display Function to render the interface graphics
-         * @param updateInterface Function for background update tasks
+         * @param display Callback to render the interface graphics
+         * @param updateInterface Callback for background update tasks
          */
         Interface (std::vector<std::vector<double>>* button_coord,
                    std::vector<Interface*>* linked_Interface,
-                   void (*actions)(int),
-                   void (*display)(),
-                   int (*updateInterface)()); 
+                   ActionCallback actions,
+                   DisplayCallback display,
+                   UpdateCallback updateInterface); 
+
+        /**
+         * @brief Copy constructor (copies the current state)
+         * @note The cached frame and the update task are not shared; the
+         *       copy starts without them
+         */
+        Interface (const Interface& other);
+
+        /**
+         * @brief Copy assignment (copies the current state)
+         * @note Stops this interface's update task first. The cached frame
+         *       and the update task are not shared; the copy starts
+         *       without them
+         */
+        Interface& operator= (const Interface& other);
+
+        /**
+         * @brief Destructor
+         * @note Stops the update task and releases the cached frame back to
+         *       the NavHistory snapshot budget
+         */
+        ~Interface ();
 
         /*---------------------------------------------------------------------
          * PUBLIC METHODS
@@ -264,6 +434,7 @@ class Interface
          * @brief Get the current interface state
          *
          * @return int Current index value
+         *         -3 = Transitioning (navigating away)
          *         -2 = Inactive (not displayed)
          *         -1 = Active (displayed, waiting for input)
          *        >=0 = Button index that was pressed
@@ -280,6 +451,96 @@ class Interface
          */
         void setIndex(int i);
 
+        /**
+         * @brief Allow the display() output to be cached for instant Back
+         *
+         * When enabled, Display() captures the frame drawn by display()
+         * into an off-screen snapshot (within the NavHistory memory cap).
+         * Enable it only for interfaces drawn entirely with drawImageRLE(),
+         * such as the built-in screens; direct Brain.Screen drawing is not
+         * captured. Dynamic content belongs in updateInterface(), which is
+         * resumed after a restore.
+         *
+         * @param enable true to capture snapshots of this interface
+         */
+        void setCacheable(bool enable);
+
+        /**
+         * @brief Name the interface for diagnostics
+         *
+         * Shown next to its timings on the Perf screen. Not used for
+         * navigation.
+         *
+         * @param name Static string, e.g. "Home"
+         */
+        void setName(const char* name);
+
+        /**
+         * @brief Name given with setName(), or nullptr
+         */
+        const char* getName();
+
+        /**
+         * @brief Record display() into a RenderBuffer and draw it optimized
+         *
+         * Display() brackets display() with begin()/end() on the shared
+         * buffer (getRenderBuffer()), so drawImageRLE() runs are merged
+         * and grouped by color before they reach the screen. Hand-written
+         * display() functions should draw through getRenderBuffer() too;
+         * direct Brain.Screen calls are drawn before the buffered content.
+         *
+         * @param enable true to buffer this interface's display()
+         */
+        void setBuffered(bool enable);
+
+        /**
+         * @brief Describe the interface on the controller screen
+         *
+         * While the ControllerMirror is running, the callback is called when
+         * the interface is shown and after each update pass. It should set
+         * up to MIRROR_ROWS lines with ControllerMirror::setLine() or
+         * print(); only changed characters reach the controller.
+         *
+         * @param mirror Callback writing the condensed text
+         */
+        void setMirror(DisplayCallback mirror);
+
+        /**
+         * @brief Set the time budget of this interface's callbacks
+         *
+         * display(), each updateInterface() pass and each action are timed
+         * against it; overruns are recorded by the Watchdog. With
+         * BUDGET_THROTTLE, after WATCHDOG_STRIKES update overruns in a row
+         * the update task skips passes, doubling its period up to
+         * WATCHDOG_MAX_BACKOFF times, and speeds up again once passes fit.
+         *
+         * @param us Budget in microseconds, 0 for unlimited
+         *           (default WATCHDOG_DEFAULT_BUDGET)
+         * @param policy BUDGET_REPORT or BUDGET_THROTTLE
+         */
+        void setBudget(uint32_t us, BudgetPolicy policy = BUDGET_REPORT);
+
+        /**
+         * @brief Budget given with setBudget() (us)
+         */
+        uint32_t getBudget();
+
+        /**
+         * @brief Update period multiplier, above 1 while throttled
+         */
+        int getBackoff();
+
+        /**
+         * @brief Shared RenderBuffer used by buffered interfaces
+         * @return RenderBuffer* Buffer, or nullptr if it could not be allocated
+         */
+        static RenderBuffer* getRenderBuffer();
+
+        /**
+         * @brief Counters of the last buffered Display()
+         */
+        static RenderStats getRenderStats();
+
         /**
          * @brief Detect which button was pressed based on touch coordinates
          *
@@ -295,7 +556,7 @@ class Interface
         /**
          * @brief Render the interface on the Brain screen
          *
-         * Calls the display() function pointer to draw the interface graphics.
+         * Calls the display() callback to draw the interface graphics.
          * If an updateInterface() function is provided, launches it as a
          * background task.
          *
@@ -307,8 +568,8 @@ class Interface
          * @brief Background update task wrapper function
          *
          * Internal method that runs the updateInterface() function in a loop
-         * while the interface is active (index == -1). Stops when interface
-         * is deactivated.
+         * while the interface is active or handling a press. Stops as soon as
+         * the interface starts transitioning away or is deactivated.
          *
          * @return int Always returns 0 when loop exits
          *
@@ -342,22 +603,32 @@ class Interface
         /**
          * @brief Execute the action callback function
          *
-         * Calls the actions() function pointer with the current button index.
-         * Triggered automatically by activate() when a button is pressed.
+         * Calls the actions() callback with the current button index.
          *
-         * @note Only called if actions() function pointer is not null
+         * @note Only called if an actions() callback is set
          */
         void Action();
 
+        /**
+         * @brief Execute the action callback for a specific button
+         *
+         * Triggered automatically by activate() when a button is pressed.
+         *
+         * @param button Index of the pressed button
+         */
+        void Action(int button);
+
         /**
          * @brief Main interface state machine
          *
          * Handles the complete interface lifecycle:
          * 1. Check if this interface is active (index == -1)
-         * 2. Detect button presses via InterfaceChooser()
-         * 3. Navigate to child interfaces if linked_Interface exists
+         * 2. Detect button presses via InterfaceChooser() (ACTIVE -> PRESSED)
+         * 3. Navigate to the linked interface for that button, if any
+         *    (PRESSED -> TRANSITIONING -> INACTIVE). Targets already in the
+         *    navigation history (and Interface::Back) are restored from it.
          * 4. Execute action callbacks
-         * 5. Manage interface state transitions
+         * 5. Return to ACTIVE when the button only has an action
          *
          * @note Must be called regularly in main loop for all interfaces
          *
@@ -388,4 +659,228 @@ class Interface
         static void reset();
 };
 
-/* ---------- Auton Class coming soon.... ------------ */
+/*-----------------------------------------------------------------------------
+ * NAVIGATION HISTORY
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Maximum number of screens remembered by the navigation history
+ */
+#define NAV_HISTORY_DEPTH 8
+
+/**
+ * @brief Default memory cap for cached snapshots (4 full-screen frames)
+ */
+#define NAV_SNAPSHOT_BUDGET (4 * FRAME_BYTES)
+
+/**
+ * @class NavHistory
+ * @brief Bounded back-stack of visited interfaces with cached snapshots
+ *
+ * Interface::activate() pushes the screen it navigates away from, together
+ * with the snapshot of its last presented frame (if it is cacheable).
+ * Navigating to a screen that is already in the history, or to
+ * Interface::Back, unwinds the stack to it and restores it with a single
+ * blit. The oldest entry is dropped when the stack is full, and the
+ * oldest snapshots are released first when the memory cap is reached.
+ * A screen left through Back or for a screen below it in the history is
+ * not remembered, so its frame is released on the way out.
+ */
+class NavHistory
+{
+    private:
+        struct Entry
+        {
+            Interface* itf;         // Screen that was navigated away from
+            uint32_t* snapshot;     // Its last presented frame, or nullptr
+        };
+
+        static Entry stack[NAV_HISTORY_DEPTH];
+        static int count;
+        static uint32_t snapshotBytes;
+        static uint32_t snapshotBudget;
+    public:
+        /**
+         * @brief Remember a screen when navigating away from it
+         *
+         * @param itf Interface being left
+         * @param snapshot Its cached frame (ownership moves to the history)
+         */
+        static void push(Interface* itf, uint32_t* snapshot);
+
+        /**
+         * @brief Remove and return the most recent screen
+         *
+         * @param snapshot Receives the cached frame (ownership moves to caller)
+         * @return Interface* Previous screen, or nullptr if history is empty
+         */
+        static Interface* pop(uint32_t** snapshot);
+
+        /**
+         * @brief Unwind the history back to a given screen
+         *
+         * Entries above itf are discarded along with their snapshots.
+         *
+         * @param itf Interface to return to
+         * @param snapshot Receives its cached frame (ownership moves to caller)
+         * @return true if itf was in the history
+         */
+        static bool unwind(Interface* itf, uint32_t** snapshot);
+
+        /**
+         * @brief Forget every entry and release all retained snapshots
+         */
+        static void clear();
+
+        /**
+         * @brief Number of screens currently remembered
+         */
+        static int depth();
+
+        /**
+         * @brief Set the memory cap for snapshots (bytes)
+         *
+         * Retained snapshots are released, oldest first, until the total
+         * fits. A cap smaller than FRAME_BYTES disables snapshots.
+         *
+         * @param bytes Maximum bytes of snapshot memory
+         */
+        static void setSnapshotBudget(uint32_t bytes);
+
+        /**
+         * @brief Bytes of snapshot memory currently allocated
+         */
+        static uint32_t getSnapshotBytes();
+
+        /**
+         * @brief Allocate a frame for a new snapshot within the memory cap
+         *
+         * Releases the oldest retained snapshots if needed to make room.
+         *
+         * @return uint32_t* New frame, or nullptr if the cap does not allow one
+         */
+        static uint32_t* allocSnapshot();
+
+        /**
+         * @brief Release a frame obtained from allocSnapshot()
+         */
+        static void freeSnapshot(uint32_t* snapshot);
+};
+
+/*-----------------------------------------------------------------------------
+ * AUTON CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Maximum number of autonomous routines that can be registered
+ */
+#define AUTON_MAX_ROUTINES 16
+
+/**
+ * @class Auton
+ * @brief Autonomous routine table with touch selection and direct dispatch
+ *
+ * Routines are registered once in pre_auton() into a static table. Selector
+ * screens bind their buttons to routines with Auton::selector(); selecting a
+ * routine runs its optional setup function right away (still in pre_auton),
+ * so that autonomous() only has to call Auton::run(): one indirect call,
+ * with no screen or lookup work on the critical path.
+ *
+ * @code
+ * void pre_auton() {
+ *     Auton::add("Red AWP", redAWP, prepareRedAWP);
+ *     Auton::add("Red 1", red1);
+ *     Monitor();
+ * }
+ * void autonomous() {
+ *     Auton::run();
+ * }
+ * @endcode
+ */
+class Auton
+{
+    public:
+        /**
+         * @brief Autonomous routine or setup function
+         */
+        typedef void (*Routine)();
+    private:
+        struct Entry
+        {
+            const char* name;       // Name used by selectors
+            Routine routine;        // Called by run()
+            Routine setup;          // Called once by select(), may be nullptr
+            bool prepared;          // setup has already run
+        };
+
+        static Entry table[AUTON_MAX_ROUTINES];
+        static int count;
+
+        /**
+         * @brief Index of the selected routine, -1 if none
+         * @note Written by the selector (pre_auton), read by autonomous()
+         */
+        static std::atomic<int> selected;
+
+        /**
+         * @brief Routine dispatched by run(), cached on selection
+         */
+        static std::atomic<Routine> dispatch;
+    public:
+        /**
+         * @brief Register an autonomous routine
+         *
+         * @param name Name used to bind the routine to selector buttons
+         * @param routine Function run during the autonomous period
+         * @param setup Optional one-time preparation (path generation,
+         *              sensor calibration...) run when the routine is selected
+         * @return int Routine id, or -1 if the table is full
+         */
+        static int add(const char* name, Routine routine, Routine setup = nullptr);
+
+        /**
+         * @brief Find a registered routine by name
+         * @return int Routine id, or -1 if not found
+         */
+        static int find(const char* name);
+
+        /**
+         * @brief Select the routine to run, preparing it if needed
+         *
+         * @param id Routine id returned by add()
+         * @return true if id is a registered routine
+         */
+        static bool select(int id);
+
+        /**
+         * @brief Id of the selected routine, -1 if none
+         */
+        static int getSelected();
+
+        /**
+         * @brief Name of a routine, or nullptr for an invalid id
+         */
+        static const char* getName(int id);
+
+        /**
+         * @brief Number of registered routines
+         */
+        static int size();
+
+        /**
+         * @brief Build an action callback that selects routines by button
+         *
+         * Button n selects the routine named (*names)[n]. Empty or null
+         * names (e.g. the Home button) are ignored.
+         *
+         * @param names Routine name for each button index
+         * @return ActionCallback Callback to pass as an Interface's actions
+         */
+        static ActionCallback selector(const std::vector<const char*>* names);
+
+        /**
+         * @brief Run the selected routine
+         * @note Call from autonomous(). Does nothing if no routine is selected
+         */
+        static void run();
+};
@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       asset.h                                                   */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Assets - images streamed from the SD card            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief "WLIA" read as a little-endian uint32
+ */
+#define ASSET_MAGIC 0x41494C57
+
+/**
+ * @brief Current asset file version
+ */
+#define ASSET_VERSION 1
+
+/**
+ * @brief Bytes read from the SD card at a time (a multiple of 4)
+ */
+#define ASSET_CHUNK_BYTES 512
+
+/**
+ * @brief saveAsset() key meaning "no transparent color"
+ */
+#define ASSET_NO_KEY 0xFFFFFFFF
+
+/*-----------------------------------------------------------------------------
+ * FILE FORMAT
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Header at the start of an asset file
+ *
+ * Followed by `words` run words, little-endian (the V5 Brain and x86
+ * hosts read them directly). Each word is one run of up to 128 pixels:
+ *
+ *   bit 31      skip (transparent): only advance the cursor
+ *   bits 24-30  pixel count - 1
+ *   bits 0-23   0xRRGGBB color
+ *
+ * Like drawImageRLE(), runs wrap to the next row at `width`, and a run
+ * carries its own color, so decoding needs no palette in RAM.
+ */
+struct AssetHeader
+{
+    uint32_t magic;         // ASSET_MAGIC
+    uint16_t version;       // ASSET_VERSION
+    uint16_t width;         // image width in pixels
+    uint16_t height;        // image height in pixels
+    uint16_t flags;         // reserved, 0
+    uint32_t words;         // run words that follow
+};
+
+/*-----------------------------------------------------------------------------
+ * LOADING
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Stream an asset from the SD card onto the screen
+ *
+ * Reads the file ASSET_CHUNK_BYTES at a time and draws each run as it is
+ * decoded, so memory use does not depend on the image size. Touching
+ * runs of one color are drawn as a single line. Drawing goes through
+ * drawImageSpan(), so a capture in progress (cacheable interfaces) and a
+ * recording RenderBuffer (buffered interfaces) both see it.
+ *
+ * @param filename File on the SD card, e.g. "logo.wlia"
+ * @param x Left edge on the screen
+ * @param y Top edge on the screen
+ * @return true if the whole image was drawn; false if the file is missing
+ *         or malformed (a truncated file is drawn up to the damage)
+ */
+bool drawAsset(const char* filename, int x = 0, int y = 0);
+
+/**
+ * @brief Stream an asset from the SD card into a frame
+ *
+ * Decodes into a SCREEN_WIDTH x SCREEN_HEIGHT frame (placed at 0, 0)
+ * without touching the screen, e.g. to pre-load a snapshot that
+ * drawFrame() can present later. Skip runs leave the frame unchanged.
+ *
+ * @param filename File on the SD card
+ * @param frame SCREEN_WIDTH x SCREEN_HEIGHT pixel buffer
+ * @return true if the whole image was decoded
+ */
+bool loadAsset(const char* filename, uint32_t* frame);
+
+/*-----------------------------------------------------------------------------
+ * SAVING
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Encode pixels as an asset file on the SD card
+ *
+ * Used by `wlic-host pack` and by screenshots; written in chunks, so no
+ * encoded copy of the image is held in memory.
+ *
+ * @param filename File on the SD card (replaced if it exists)
+ * @param pixels width x height 0x00RRGGBB pixels, row by row
+ * @param width Image width
+ * @param height Image height
+ * @param key Color stored as transparent skip runs, or ASSET_NO_KEY
+ * @return true if the whole file was written
+ */
+bool saveAsset(const char* filename, const uint32_t* pixels, int width, int height,
+               uint32_t key = ASSET_NO_KEY);
+
+/**
+ * @class AssetWriter
+ * @brief Writes an asset file a slice at a time
+ *
+ * For encoders that must not stall the program (Screenshot): count the
+ * run words with countRuns(), open() the file with that count, then
+ * write() the pixels in any number of slices and close(). A run never
+ * spans two write() calls, so countRuns() must be given the same slices.
+ *
+ * @code
+ * uint32_t words = 0;
+ * for (int y = 0; y < height; y += 16)
+ *     words += AssetWriter::countRuns(pixels + y * width, 16 * width);
+ * AssetWriter writer;
+ * writer.open("shot.wlia", width, height, words);
+ * for (int y = 0; y < height; y += 16)
+ *     writer.write(pixels + y * width, 16 * width);
+ * bool ok = writer.close();
+ * @endcode
+ */
+class AssetWriter
+{
+    private:
+        FIL_T* file;
+        uint32_t chunk[ASSET_CHUNK_BYTES / 4];
+        int used;
+        uint32_t key;
+        bool ok;
+    public:
+        AssetWriter();
+        ~AssetWriter();
+
+        /**
+         * @brief Number of run words write() produces for these pixels
+         */
+        static uint32_t countRuns(const uint32_t* pixels, int count);
+
+        /**
+         * @brief Create the file and write the header
+         * @param words Total of countRuns() over every slice
+         * @param key Color stored as transparent skip runs, or ASSET_NO_KEY
+         */
+        bool open(const char* filename, int width, int height, uint32_t words,
+                  uint32_t key = ASSET_NO_KEY);
+
+        /**
+         * @brief Encode and write the next pixels, ASSET_CHUNK_BYTES at a time
+         */
+        bool write(const uint32_t* pixels, int count);
+
+        /**
+         * @brief Write what is left and close the file
+         * @return true if every write succeeded
+         */
+        bool close();
+};
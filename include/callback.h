@@ -0,0 +1,224 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       callback.h                                                */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Callback - Allocation-free callable wrapper          */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Inline storage (in bytes) reserved by every Callback
+ * @note Four pointers wide: enough for a lambda capturing an object pointer
+ *       and a few ints, or a bound member function. Override at build time
+ *       with -DWLIC_CALLBACK_CAPACITY=<bytes> if larger captures are needed.
+ */
+#ifndef WLIC_CALLBACK_CAPACITY
+#define WLIC_CALLBACK_CAPACITY (4 * sizeof(void*))
+#endif
+
+/*-----------------------------------------------------------------------------
+ * CALLBACK CLASS
+ *---------------------------------------------------------------------------*/
+
+template <typename Signature, unsigned Capacity = WLIC_CALLBACK_CAPACITY>
+class Callback;
+
+/**
+ * @class Callback
+ * @brief Small-buffer callable used for Interface actions, display and updates
+ *
+ * Holds a plain function pointer, a lambda or any other function object
+ * directly inside the Callback object. Nothing is ever allocated on the
+ * heap: the callable is placement-constructed into fixed inline storage,
+ * and a callable that does not fit is rejected at compile time rather
+ * than silently spilled to the heap.
+ *
+ * The type-erasure is a static table of plain function pointers, so it
+ * needs neither RTTI nor exceptions (the project builds with -fno-rtti
+ * and -fno-exceptions).
+ *
+ * @code
+ * int count = 0;
+ * Callback<void(int)> onPress = [&count](int button) { count += button; };
+ * onPress(2);
+ * @endcode
+ */
+template <typename R, typename... Args, unsigned Capacity>
+class Callback<R(Args...), Capacity>
+{
+    private:
+        /**
+         * @brief Per-type operation table shared by every Callback holding F
+         */
+        struct Ops
+        {
+            R    (*invoke)(void* storage, Args... args);
+            void (*copy)(void* dst, const void* src);
+            void (*destroy)(void* storage);
+        };
+
+        template <typename F>
+        struct Handler
+        {
+            static R invoke(void* storage, Args... args)
+            {
+                return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+            }
+            static void copy(void* dst, const void* src)
+            {
+                new (dst) F(*static_cast<const F*>(src));
+            }
+            static void destroy(void* storage)
+            {
+                static_cast<F*>(storage)->~F();
+            }
+            static const Ops* table()
+            {
+                static const Ops ops = { &invoke, &copy, &destroy };
+                return &ops;
+            }
+        };
+
+        /**
+         * @brief True for any F that is not a Callback, can be called with
+         *        Args... and returns something convertible to R
+         *
+         * Checked here, so a callable with the wrong signature drops out of
+         * overload resolution (e.g. between the Interface constructors)
+         * instead of failing to compile inside Handler::invoke.
+         */
+        template <typename T>
+        struct Void { typedef void type; };
+
+        template <typename D, typename = void>
+        struct Callable : std::false_type {};
+
+        template <typename D>
+        struct Callable<D, typename Void<decltype(std::declval<D&>()(std::declval<Args>()...))>::type>
+            : std::integral_constant<bool, !std::is_same<D, Callback>::value &&
+                                           std::is_convertible<decltype(std::declval<D&>()(std::declval<Args>()...)),
+                                                               R>::value> {};
+
+        template <typename F>
+        static bool isNull(const F&) { return false; }
+        template <typename T>
+        static bool isNull(T* fn) { return fn == nullptr; }
+
+        /**
+         * @brief Inline storage for the wrapped callable
+         */
+        mutable typename std::aligned_storage<Capacity, alignof(double)>::type storage;
+
+        /**
+         * @brief Operation table for the stored callable, nullptr when empty
+         */
+        const Ops* ops;
+
+    public:
+        /*---------------------------------------------------------------------
+         * CONSTRUCTORS
+         *-------------------------------------------------------------------*/
+
+        /**
+         * @brief Creates an empty callback
+         */
+        Callback () : ops(nullptr) {}
+
+        /**
+         * @brief Creates an empty callback (allows passing nullptr)
+         */
+        Callback (std::nullptr_t) : ops(nullptr) {}
+
+        /**
+         * @brief Wraps a function pointer, lambda or function object
+         *
+         * A null function pointer produces an empty callback, so existing
+         * code passing nullptr-valued function pointers keeps working.
+         *
+         * @param f Callable to store (copied into the inline buffer)
+         */
+        template <typename F,
+                  typename std::enable_if<Callable<typename std::decay<F>::type>::value, int>::type = 0>
+        Callback (F f) : ops(nullptr)
+        {
+            typedef typename std::decay<F>::type D;
+            static_assert(sizeof(D) <= Capacity,
+                          "Callable too large for Callback inline storage; "
+                          "capture less or raise WLIC_CALLBACK_CAPACITY");
+            static_assert(alignof(D) <= alignof(double),
+                          "Callable alignment exceeds Callback storage alignment");
+            if (!isNull(f))
+            {
+                new (&storage) D(std::move(f));
+                ops = Handler<D>::table();
+            }
+        }
+
+        Callback (const Callback& other) : ops(other.ops)
+        {
+            if (ops)
+            {
+                ops->copy(&storage, &other.storage);
+            }
+        }
+
+        Callback& operator= (const Callback& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (other.ops)
+                {
+                    other.ops->copy(&storage, &other.storage);
+                    ops = other.ops;
+                }
+            }
+            return *this;
+        }
+
+        ~Callback ()
+        {
+            clear();
+        }
+
+        /*---------------------------------------------------------------------
+         * PUBLIC METHODS
+         *-------------------------------------------------------------------*/
+
+        /**
+         * @brief Destroy the stored callable, leaving the callback empty
+         */
+        void clear()
+        {
+            if (ops)
+            {
+                ops->destroy(&storage);
+                ops = nullptr;
+            }
+        }
+
+        /**
+         * @brief True if a callable is stored
+         */
+        explicit operator bool() const
+        {
+            return ops != nullptr;
+        }
+
+        /**
+         * @brief Invoke the stored callable
+         * @note Must not be called on an empty callback; check with
+         *       operator bool first (as Interface does)
+         */
+        R operator() (Args... args) const
+        {
+            return ops->invoke(&storage, std::forward<Args>(args)...);
+        }
+};
@@ -14,10 +14,11 @@
  *---------------------------------------------------------------------------*/
 
 /**
- * @brief Global status message string
- * @note Used to display system status or messages across interfaces
+ * @brief Global status message channel
+ * @note Used to display system status or messages across interfaces.
+ *       Safe to write from any task without allocating (see status.h)
  */
-extern std::string status;
+extern StatusChannel status;
 
 /*-----------------------------------------------------------------------------
  * STATUS AND PERFORMANCE FUNCTIONS
@@ -25,9 +26,17 @@ extern std::string status;
 
 /**
  * @brief Set the global status message
+ * @param stat The status text to display (truncated to STATUS_LENGTH - 1)
+ * @note Does not allocate; safe to call from autonomous/usercontrol loops
+ */
+void setStatus(const char* stat);
+
+/**
+ * @brief Set the global status message from a std::string
  * @param stat The status string to display
+ * @note Kept for compatibility; prefer the const char* overload on hot paths
  */
-void setStatus(std::string stat);
+void setStatus(const std::string& stat);
 
 /**
  * @brief Background task that prints performance metrics on screen
@@ -36,6 +45,11 @@ void setStatus(std::string stat);
  */
 int printPerformance();
 
+/**
+ * @brief Controller version of the Home screen: status and drive motors
+ */
+void mirrorHome();
+
 /*-----------------------------------------------------------------------------
  * HOME INTERFACE
  *---------------------------------------------------------------------------*/
@@ -64,6 +78,11 @@ void drawdirection(double heading);
  */
 int drawHeading();
 
+/**
+ * @brief Controller version of the Heading screen
+ */
+void mirrorHeading();
+
 /**
  * @brief Render the Heading interface (compass display)
  * @note Shows robot orientation with visual compass indicator
@@ -76,10 +95,19 @@ void displayHeading();
 
 /**
  * @brief Render the Ports interface (motor and sensor status)
- * @note Displays connection status and information for all V5 ports
+ * @note Draws the port grid and invalidates the PortMap, so the next
+ *       drawPorts() fills in every cell
  */
 void displayPorts();
 
+/**
+ * @brief Background task that keeps the port cells up to date
+ * @return int Always returns 0 when complete
+ * @note Scans the ports with PortMap::poll() and redraws only the cells
+ *       that changed
+ */
+int drawPorts();
+
 /*-----------------------------------------------------------------------------
  * AUTONOMOUS SELECTION INTERFACES
  *---------------------------------------------------------------------------*/
@@ -90,6 +118,11 @@ void displayPorts();
  */
 void displayAuton();
 
+/**
+ * @brief Controller version of the autonomous screens: the selected routine
+ */
+void mirrorAuton();
+
 /**
  * @brief Render the Red Alliance autonomous selection interface
  * @note Shows available autonomous routines for red alliance
@@ -106,9 +139,16 @@ void displayAutonBlue();
  * UTILITY INTERFACES
  *---------------------------------------------------------------------------*/
 
+/**
+ * @brief SD card file that replaces the compiled-in logo when present
+ */
+#define LOGO_ASSET "logo.wlia"
+
 /**
  * @brief Render the Logo interface (team branding)
- * @note Displays team logo and branding information
+ * @note Displays team logo and branding information. Streams LOGO_ASSET
+ *       from the SD card if it exists, so the logo can be changed
+ *       without rebuilding
  */
 void displayLogo();
 
@@ -118,10 +158,61 @@ void displayLogo();
  */
 void displayUtil();
 
+/*-----------------------------------------------------------------------------
+ * PERFORMANCE INTERFACE
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Render the Perf interface (timing histograms, Util > Z)
+ * @note Draws the header and the Back, On/Off and Clear buttons
+ */
+void displayPerf();
+
+/**
+ * @brief Background task that prints p50/p95/max of every Perf histogram
+ * @return int Always returns 0 when complete
+ */
+int drawPerf();
+
+/*-----------------------------------------------------------------------------
+ * FIELD INTERFACE
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Render the Field interface (robot pose on the field, Util > X)
+ * @note Draws the Back and Clear buttons and invalidates the FieldMap, so
+ *       the next drawField() draws the map and the whole trail
+ */
+void displayField();
+
+/**
+ * @brief Background task that moves the robot on the field map
+ * @return int Always returns 0 when complete
+ * @note Draws only the new trail segments and the marker, and prints the
+ *       pose when it changes
+ */
+int drawField();
+
 /*-----------------------------------------------------------------------------
  * MAIN MONITOR FUNCTION
  *---------------------------------------------------------------------------*/
 
+/**
+ * @brief Build the built-in menu and display the Home interface
+ * @note Loads the saved UIState: the saved routine is selected again and
+ *       the menu opens on the saved screen (Home if there is none). Can be
+ *       called again to restart the menu
+ */
+void MonitorSetup();
+
+/**
+ * @brief Run one pass of the built-in menu loop
+ * @note Activates every built-in interface once, then Interface::reset(),
+ *       then records the active screen and routine in UIState and lets it
+ *       save. Monitor() calls this every 100 ms; host tools call it directly
+ */
+void MonitorStep();
+
 /**
  * @brief Initialize and launch the WLIC interface system
  * @return int Always returns 0 when complete
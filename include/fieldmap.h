@@ -0,0 +1,203 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       fieldmap.h                                                */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Field Map - Robot pose and odometry trail            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Points kept in the trail (4 bytes each)
+ */
+#define FIELDMAP_TRAIL_POINTS 256
+
+/**
+ * @brief Shortest distance between two trail points at the start (cm)
+ */
+#define FIELDMAP_STEP_CM 2.0
+
+/**
+ * @brief A straight run keeps a point every this many steps
+ */
+#define FIELDMAP_STRAIGHT_STEPS 15
+
+/**
+ * @brief A change of direction of this much keeps a point (degrees)
+ */
+#define FIELDMAP_TURN_DEG 10.0
+
+/**
+ * @brief Side of the field, 12 feet (cm)
+ */
+#define FIELDMAP_FIELD_CM 365.76
+
+/**
+ * @brief Position and side of the map on the Field screen (pixels)
+ */
+#define FIELDMAP_LEFT 10
+#define FIELDMAP_TOP  10
+#define FIELDMAP_SIZE 216
+
+/**
+ * @brief Half the side of the box holding the robot marker (pixels)
+ */
+#define FIELDMAP_MARKER 8
+
+/*-----------------------------------------------------------------------------
+ * POSE
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Where the robot is on the field
+ *
+ * x and y are in cm from the center of the field, x to the right and y
+ * away from the driver station. heading is in degrees, clockwise from +y,
+ * like inertial::heading().
+ */
+struct Pose
+{
+    double x;
+    double y;
+    double heading;
+};
+
+/**
+ * @brief Fills in the current pose, e.g. from your odometry
+ * @return false if there is no pose yet
+ */
+typedef bool (*PoseProvider)(Pose& pose);
+
+/**
+ * @brief Counters from FieldMap::getStats()
+ */
+struct FieldMapStats
+{
+    uint32_t samples;       // poses given to add()
+    uint32_t points;        // points in the trail now
+    uint32_t thinned;       // times the full trail was halved
+    uint32_t segments;      // trail segments drawn by draw()
+    uint32_t markers;       // times the robot marker was moved
+};
+
+/*-----------------------------------------------------------------------------
+ * FIELD MAP CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class FieldMap
+ * @brief Plots the robot's pose and the path it drove on a field map
+ *
+ * add() keeps a pose in the trail only if it is FIELDMAP_STEP_CM from the
+ * last point and either turns by FIELDMAP_TURN_DEG or has gone
+ * FIELDMAP_STRAIGHT_STEPS steps in a straight line, so straights cost a
+ * point every 30 cm and curves keep their shape. When the trail is full,
+ * every other point is dropped and the step doubles: memory stays at
+ * FIELDMAP_TRAIL_POINTS for a whole match, and the trail always covers
+ * it from the start.
+ *
+ * draw() runs from the Field screen's update task (drawField()). It draws
+ * only the segments added since the last call, then moves the robot
+ * marker: the marker's box is filled with the field color and the grid
+ * and trail segments crossing it are drawn again. The whole map is only
+ * drawn after invalidate().
+ *
+ * @code
+ * bool odometryPose(Pose& pose) {          // in your code
+ *     pose.x = robotX; pose.y = robotY;
+ *     pose.heading = gyro1.heading(degrees);
+ *     return true;
+ * }
+ * FieldMap::start(odometryPose, 20);       // sample every 20 ms
+ * @endcode
+ */
+class FieldMap
+{
+    private:
+        static std::atomic<uint32_t> trail[FIELDMAP_TRAIL_POINTS];     // packPoint()
+        static std::atomic<int> count;
+        static std::atomic<uint32_t> generation;    // odd while the trail is rewritten
+        static std::atomic<uint32_t> cleared;       // clears done by add()
+        static std::atomic<bool> clearRequested;
+        static std::atomic<int32_t> poseX, poseY, poseHeading;     // mm, 0.1 degree
+        static std::atomic<bool> hasPose;
+
+        // add() only
+        static double step;
+        static double lastDirection;
+
+        // draw() only
+        static std::atomic<bool> invalid;
+        static uint32_t shown[FIELDMAP_TRAIL_POINTS];      // copy of the trail
+        static int shownCount;
+        static int drawnCount;
+        static uint32_t drawnGeneration;
+        static uint32_t drawnCleared;
+        static bool markerDrawn;
+        static int markerX, markerY, markerHeading;
+
+        static PoseProvider provider;
+        static uint32_t samplePeriod;
+        static task* sampler;
+        static std::atomic<uint32_t> samples, thinned, segments, markers;
+
+        static uint32_t packPoint(double x, double y);
+        static void toScreen(uint32_t point, int& px, int& py);
+        static void thin();
+        static void drawBackground();
+        static void drawMarker(int x, int y, int heading);
+        static void eraseMarker();
+        static bool copyTrail();
+        static int sampleTask();
+    public:
+        /**
+         * @brief Sample a pose provider from a background task
+         * @param poseProvider Called every period
+         * @param periodMs Sampling period
+         */
+        static void start(PoseProvider poseProvider, uint32_t periodMs = 20);
+
+        /**
+         * @brief Stop the task started by start()
+         */
+        static void stop();
+
+        /**
+         * @brief Record a pose; call from one task only (start() does)
+         * @param x cm right of the field center
+         * @param y cm away from the driver station
+         * @param heading Degrees clockwise from +y
+         */
+        static void add(double x, double y, double heading);
+
+        /**
+         * @brief Forget the trail; done by the next add()
+         */
+        static void clear();
+
+        /**
+         * @brief Draw new trail segments and move the robot marker
+         *
+         * After invalidate(), draws the field and the whole trail first.
+         * Draws with Brain.Screen directly, from the update task.
+         *
+         * @return int Number of trail segments drawn
+         */
+        static int draw();
+
+        /**
+         * @brief Forget what is on screen, so the next draw() redraws it all
+         * @note Called by displayField() whenever the screen is shown
+         */
+        static void invalidate();
+
+        /**
+         * @brief Last pose given to add()
+         * @return false if there is none yet
+         */
+        static bool getPose(Pose& pose);
+
+        static FieldMapStats getStats();
+};
@@ -0,0 +1,220 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       glyph.h                                                   */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Glyphs - Bitmap fonts drawn as blocks                */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Longest string a GlyphText shows
+ */
+#define GLYPH_TEXT_CELLS 16
+
+/*-----------------------------------------------------------------------------
+ * FONTS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief A pre-rasterized bitmap font
+ *
+ * One byte per glyph row, bit 7 being the leftmost pixel, so a glyph is
+ * at most 8 pixels wide and costs `height` bytes.
+ */
+struct GlyphFont
+{
+    uint8_t width;          // pixels, at most 8
+    uint8_t height;         // pixels, at most 16
+    uint8_t spacing;        // blank columns after each glyph
+    char first;             // character of the first glyph
+    uint8_t count;          // glyphs in rows
+    const uint8_t* rows;    // height bytes per glyph
+};
+
+/**
+ * @brief Printable ASCII, 5 x 7
+ */
+extern const GlyphFont glyphFont5x7;
+
+/**
+ * @brief Large digits, 8 x 12: 0-9 and space + - . / : %
+ */
+extern const GlyphFont glyphFontDigits;
+
+/**
+ * @brief Where a GlyphText puts a string shorter than its cells
+ */
+enum GlyphAlign
+{
+    GLYPH_LEFT  = 0,
+    GLYPH_RIGHT = 1         // numbers: the units stay in the same cell
+};
+
+/*-----------------------------------------------------------------------------
+ * GLYPH ATLAS CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class GlyphAtlas
+ * @brief A font cut into solid blocks, ready to draw
+ *
+ * The constructor splits every glyph row into runs of ink and paper (the
+ * spacing columns are paper), then joins runs that repeat on the next row
+ * into one taller block. A glyph is drawn as its blocks through
+ * drawImageBlock(), one rectangle each. Blocks are scaled up with the
+ * glyph, so large digits cost no more calls than small ones.
+ *
+ * Drawing goes through render.h, so text drawn this way is captured by
+ * cacheable interfaces and tracked for screenshots, unlike
+ * Brain.Screen.print().
+ *
+ * @code
+ * glyphSmall.drawText("Ready", 10, 10, 2, 0xFFFFFF, 0x000000);
+ * @endcode
+ */
+class GlyphAtlas
+{
+    private:
+        const GlyphFont* font;
+        uint32_t* blocks;           // see glyph.cpp for the packing
+        uint16_t* firstBlock;       // font->count + 1 offsets into blocks
+        int blockCount;
+
+        GlyphAtlas (const GlyphAtlas&);
+        GlyphAtlas& operator=(const GlyphAtlas&);
+    public:
+        /**
+         * @brief Cut a font into blocks
+         * @note Allocates about 4 bytes per block; check isReady()
+         */
+        GlyphAtlas (const GlyphFont& font);
+        ~GlyphAtlas ();
+
+        /**
+         * @brief false if the blocks could not be allocated; nothing is drawn
+         */
+        bool isReady() const;
+
+        /**
+         * @brief Blocks in the whole atlas
+         */
+        int size() const;
+
+        /**
+         * @brief Space taken by one glyph, spacing included (pixels)
+         */
+        int cellWidth(int scale = 1) const;
+        int cellHeight(int scale = 1) const;
+
+        /**
+         * @brief Draw one character
+         *
+         * A character missing from the font is drawn as a blank cell.
+         *
+         * @param c Character
+         * @param x Left edge
+         * @param y Top edge
+         * @param scale Size of one font pixel on the screen
+         * @param ink 0x00RRGGBB color of the glyph
+         * @param paper 0x00RRGGBB color behind it, or RENDER_TRANSPARENT to
+         *        leave the background alone
+         * @return int Blocks drawn
+         */
+        int drawGlyph(char c, int x, int y, int scale, uint32_t ink, uint32_t paper) const;
+
+        /**
+         * @brief Draw a string on one line
+         * @return int Blocks drawn
+         */
+        int drawText(const char* text, int x, int y, int scale, uint32_t ink, uint32_t paper) const;
+};
+
+/**
+ * @brief Atlases of the built-in fonts
+ */
+extern GlyphAtlas glyphSmall;
+extern GlyphAtlas glyphDigits;
+
+/*-----------------------------------------------------------------------------
+ * GLYPH TEXT CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class GlyphText
+ * @brief A fixed field of glyph cells that redraws only what changed
+ *
+ * set() compares the new string with the one on screen, cell by cell,
+ * and draws only the cells that differ, so a value ticking from 12.3 to
+ * 12.4 draws one digit instead of the whole line. Shorter strings are
+ * padded with spaces, which erases what was there before.
+ *
+ * Whenever a whole screen is drawn (an interface is displayed or restored
+ * from its snapshot, see getScreenGeneration()), the next set() draws
+ * every cell again. Use a GlyphText from one task only, e.g. the update
+ * task of its screen.
+ *
+ * @code
+ * static GlyphText speed(glyphDigits, 40, 150, 5, 2, GLYPH_RIGHT);
+ * int drawSpeed() {                        // update task
+ *     speed.print("%.1f", Left.velocity(rpm));
+ *     return 0;
+ * }
+ * @endcode
+ */
+class GlyphText
+{
+    private:
+        const GlyphAtlas* atlas;
+        int x, y;
+        int cells;
+        int scale;
+        GlyphAlign align;
+        uint32_t ink, paper;
+        char shown[GLYPH_TEXT_CELLS];
+        bool valid;
+        uint32_t generation;
+    public:
+        /**
+         * @param atlas Font to draw with
+         * @param x Left edge of the first cell
+         * @param y Top edge
+         * @param cells Characters shown, at most GLYPH_TEXT_CELLS
+         * @param scale Size of one font pixel on the screen
+         * @param align Side strings shorter than cells start from
+         */
+        GlyphText (const GlyphAtlas& atlas, int x, int y, int cells, int scale = 1,
+                   GlyphAlign align = GLYPH_LEFT);
+
+        /**
+         * @brief Colors used from the next set(), which then redraws every
+         *        cell if they changed (default white on black)
+         * @param paper 0x00RRGGBB, or RENDER_TRANSPARENT (then changed cells
+         *        are not erased: only use it on a background you redraw)
+         */
+        void setColors(uint32_t ink, uint32_t paper);
+
+        /**
+         * @brief Show a string, drawing only the cells that changed
+         * @return int Cells drawn
+         */
+        int set(const char* text);
+
+        /**
+         * @brief printf into the cells
+         * @return int Cells drawn
+         */
+        int print(const char* format, ...);
+
+        /**
+         * @brief Draw every cell on the next set()
+         */
+        void invalidate();
+
+        /**
+         * @brief Width of all the cells (pixels)
+         */
+        int width() const;
+};
@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       health.h                                                  */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Motor Health - Smoothed temperatures and alerts      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Motors that can be watched
+ */
+#define MOTORHEALTH_MOTORS 8
+
+/**
+ * @brief Functions that can subscribe to alerts
+ */
+#define MOTORHEALTH_LISTENERS 4
+
+/**
+ * @brief Time between two samples of every motor (ms)
+ */
+#define MOTORHEALTH_PERIOD_MS 100
+
+/**
+ * @brief Time constants of the temperature and rate averages (s)
+ */
+#define MOTORHEALTH_SMOOTH_S 2.0f
+#define MOTORHEALTH_RATE_SMOOTH_S 10.0f
+
+/**
+ * @brief Temperature at which a V5 motor starts limiting its current (C)
+ */
+#define MOTORHEALTH_LIMIT_C 55.0f
+
+/**
+ * @brief Temperature that raises a warning (C)
+ */
+#define MOTORHEALTH_WARM_C 45.0f
+
+/**
+ * @brief Also warn when the limit is this close at the current rate (s)
+ */
+#define MOTORHEALTH_WARN_S 60.0f
+
+/**
+ * @brief A level is left only once the motor is this much below it (C)
+ */
+#define MOTORHEALTH_HYSTERESIS_C 2.0f
+
+/**
+ * @brief timeToLimit() when the motor is not heating up (s)
+ */
+#define MOTORHEALTH_NEVER 9999
+
+/*-----------------------------------------------------------------------------
+ * HEALTH LEVEL
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief How close a motor is to thermal limiting
+ */
+enum HealthLevel
+{
+    HEALTH_OK   = 0,        // cool and not heading for the limit soon
+    HEALTH_WARM = 1,        // above MOTORHEALTH_WARM_C, or at the limit within MOTORHEALTH_WARN_S
+    HEALTH_HOT  = 2         // at MOTORHEALTH_LIMIT_C: the motor is limiting its current
+};
+
+/**
+ * @brief Called when a motor changes level
+ * @param motor Index given by MotorHealth::watch()
+ * @param level The new level
+ */
+typedef Callback<void(int motor, HealthLevel level)> HealthListener;
+
+/*-----------------------------------------------------------------------------
+ * MOTOR HEALTH CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class MotorHealth
+ * @brief Smoothed motor temperatures, heating rates and thermal alerts
+ *
+ * A background task reads every watched motor each MOTORHEALTH_PERIOD_MS,
+ * then updates all of them in one pass over plain float arrays (one array
+ * per quantity rather than one struct per motor): an exponential moving
+ * average of the temperature, a smoothed rate of change and the time left
+ * before MOTORHEALTH_LIMIT_C. The pass has no branches and a fixed trip
+ * count, so the compiler can vectorize it.
+ *
+ * Each motor then gets a HealthLevel, with hysteresis so a reading near a
+ * threshold does not flicker. Listeners are called from the task only
+ * when a level changes, so the UI does not poll each motor for alerts.
+ * Results are published as atomics and can be read from any task.
+ *
+ * @code
+ * MotorHealth::watch(L1, "L1");        // MonitorSetup() watches the drive
+ * MotorHealth::subscribe([](int motor, HealthLevel level) {
+ *     if (level == HEALTH_HOT) { setStatus("Motor hot"); }
+ * });
+ * MotorHealth::start();
+ * @endcode
+ */
+class MotorHealth
+{
+    private:
+        // sampler task only, one entry per motor
+        static float raw[MOTORHEALTH_MOTORS];           // C
+        static float average[MOTORHEALTH_MOTORS];       // C
+        static float rate[MOTORHEALTH_MOTORS];          // C per second
+        static float remaining[MOTORHEALTH_MOTORS];     // s to MOTORHEALTH_LIMIT_C
+        static uint8_t levels[MOTORHEALTH_MOTORS];      // HealthLevel
+        static bool primed[MOTORHEALTH_MOTORS];         // average started from a reading
+
+        static motor* motors[MOTORHEALTH_MOTORS];
+        static const char* names[MOTORHEALTH_MOTORS];
+        static std::atomic<int> motorCount;
+
+        // published after each pass
+        static std::atomic<int16_t> shownTemperature[MOTORHEALTH_MOTORS];     // 0.1 C
+        static std::atomic<int16_t> shownRate[MOTORHEALTH_MOTORS];            // 0.01 C/s
+        static std::atomic<int16_t> shownRemaining[MOTORHEALTH_MOTORS];       // s
+        static std::atomic<uint8_t> shownLevel[MOTORHEALTH_MOTORS];
+
+        static HealthListener listeners[MOTORHEALTH_LISTENERS];
+        static std::atomic<int> listenerCount;
+        static task* sampler;
+        static std::atomic<uint32_t> samples, alerts;
+
+        static void smooth(float dt);
+        static HealthLevel classify(int i);
+        static int sampleTask();
+    public:
+        /**
+         * @brief Watch a motor's temperature, before or after start()
+         *
+         * The new motor's average starts from its first reading; the
+         * motors already watched keep theirs.
+         *
+         * @param m Motor
+         * @param name Short name used in alerts, e.g. "L1"
+         * @return int Index of the motor (the same one if it is already
+         *         watched), -1 if MOTORHEALTH_MOTORS are watched
+         */
+        static int watch(motor& m, const char* name);
+
+        /**
+         * @brief Call a function whenever a motor changes level
+         * @note Runs in the sampler task: keep it short (setStatus() is fine)
+         * @return false if MOTORHEALTH_LISTENERS are subscribed
+         */
+        static bool subscribe(HealthListener listener);
+
+        /**
+         * @brief Forget every watched motor and listener, and stop sampling
+         */
+        static void reset();
+
+        /**
+         * @brief Start sampling every MOTORHEALTH_PERIOD_MS
+         */
+        static void start();
+
+        static void stop();
+
+        /**
+         * @brief Read every motor and update the averages once
+         * @param dt Seconds since the last sample
+         * @note The sampler task calls this; call it yourself only without start()
+         */
+        static void sample(float dt);
+
+        static int count();
+
+        /**
+         * @brief Index of a watched motor, -1 if it is not watched
+         */
+        static int find(motor& m);
+
+        static const char* name(int i);
+
+        /**
+         * @brief Smoothed temperature (C)
+         */
+        static double temperature(int i);
+
+        /**
+         * @brief Smoothed heating rate (C per second, negative when cooling)
+         */
+        static double heatingRate(int i);
+
+        /**
+         * @brief Seconds until MOTORHEALTH_LIMIT_C at the current rate
+         * @return MOTORHEALTH_NEVER if the motor is not heating up
+         */
+        static int timeToLimit(int i);
+
+        static HealthLevel level(int i);
+
+        /**
+         * @brief Hottest level of all watched motors
+         */
+        static HealthLevel worst();
+
+        /**
+         * @brief Samples taken and level changes reported since reset()
+         */
+        static uint32_t sampleCount();
+        static uint32_t alertCount();
+};
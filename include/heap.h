@@ -0,0 +1,156 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       heap.h                                                    */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Heap Tracker - Allocation counts per subsystem       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Length of a report() line, newline included
+ */
+#define HEAP_REPORT_LINE 64
+
+/**
+ * @brief Subsystem an allocation is counted against
+ */
+enum HeapTag
+{
+    HEAP_OTHER   = 0,       // outside any HeapScope, e.g. the user program
+    HEAP_RENDER  = 1,       // RenderBuffer, glyph atlases, the Screenshot tracking frame
+    HEAP_TASKS   = 2,       // update and service tasks
+    HEAP_ASSETS  = 3,       // asset loading and writing, screenshots until they are encoded
+    HEAP_WIDGETS = 4,       // the built-in menu's button, link and routine tables
+    HEAP_HISTORY = 5,       // interface snapshots kept for Back
+    HEAP_TAGS    = 6
+};
+
+/**
+ * @brief Counters from HeapTracker::getStats()
+ */
+struct HeapStats
+{
+    uint32_t allocations;   // blocks allocated since the program started
+    uint32_t frees;         // blocks freed since the program started
+    uint32_t blocks;        // blocks allocated and not freed yet
+    uint32_t bytes;         // bytes in those blocks, as asked for
+    uint32_t peak;          // most bytes live at once since resetPeak()
+};
+
+/*-----------------------------------------------------------------------------
+ * HEAP TRACKER CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class HeapTracker
+ * @brief Counts every new and delete of the program, per subsystem
+ *
+ * Opt-in at build time: with -DWLIC_TRACK_MEMORY, heap.cpp replaces the
+ * global operator new and delete, so allocations made by std::vector,
+ * std::string and tasks are counted along with the library's own. Each
+ * block then carries a small header with its size and tag. Without the
+ * define nothing is replaced, isEnabled() is false and every count is 0.
+ * make host defines it; make host-notrack builds the host tool without.
+ *
+ * A block is counted against the tag of the innermost HeapScope of the
+ * task that allocated it, and freed from that tag whoever frees it.
+ * malloc() and free() called directly are not counted.
+ *
+ * @code
+ * HeapStats heap = HeapTracker::getStats();
+ * printf("%lu bytes in %lu blocks\n", (unsigned long)heap.bytes, (unsigned long)heap.blocks);
+ * @endcode
+ */
+class HeapTracker
+{
+    private:
+        static std::atomic<uint32_t> allocations[HEAP_TAGS + 1];    // the last one is the total
+        static std::atomic<uint32_t> frees[HEAP_TAGS + 1];
+        static std::atomic<uint32_t> bytes[HEAP_TAGS + 1];
+        static std::atomic<uint32_t> peaks[HEAP_TAGS + 1];
+
+        static void count(int tag, uint32_t size);
+        static void uncount(int tag, uint32_t size);
+    public:
+        /**
+         * @brief true if built with WLIC_TRACK_MEMORY
+         */
+        static bool isEnabled();
+
+        /**
+         * @brief Counters of every tag together
+         */
+        static HeapStats getStats();
+
+        /**
+         * @brief Counters of one tag
+         */
+        static HeapStats getStats(HeapTag tag);
+
+        /**
+         * @brief Short lowercase name of a tag, e.g. "render"
+         */
+        static const char* tagName(HeapTag tag);
+
+        /**
+         * @brief Start every peak again from the bytes live now
+         */
+        static void resetPeak();
+
+        /**
+         * @brief Write a table of the counters, one line per tag and a total
+         *
+         * At most HEAP_REPORT_LINE characters per line, (HEAP_TAGS + 2)
+         * lines with the heading.
+         *
+         * @param out Buffer, always terminated
+         * @param size Size of out
+         * @return int Characters written, without the terminator
+         */
+        static int report(char* out, int size);
+
+        /**
+         * @brief Allocate a counted block for the current tag
+         * @note Called by the replaced operator new; nullptr if out of memory
+         */
+        static void* allocate(size_t size);
+
+        /**
+         * @brief Free a block from allocate() (nullptr is ignored)
+         */
+        static void release(void* block);
+};
+
+/*-----------------------------------------------------------------------------
+ * HEAP SCOPE CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class HeapScope
+ * @brief Counts allocations against a tag until the end of the block
+ *
+ * Scopes nest; the previous tag comes back when a scope ends. The tag is
+ * per task, on the host too, where tasks are threads. On the Brain do not
+ * wait inside a scope: another task resuming there would be tagged too.
+ *
+ * @code
+ * {
+ *     HeapScope scope(HEAP_RENDER);
+ *     buffer = new (std::nothrow) RenderBuffer();
+ * }
+ * @endcode
+ */
+class HeapScope
+{
+    private:
+        int previous;
+
+        HeapScope (const HeapScope&);
+        HeapScope& operator=(const HeapScope&);
+    public:
+        HeapScope (HeapTag tag);
+        ~HeapScope ();
+};
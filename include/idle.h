@@ -0,0 +1,136 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       idle.h                                                    */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Idle Policy - Slow down while nothing changes        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Time without a touch or a change before going idle (ms)
+ */
+#define IDLE_TIMEOUT_MS 30000
+
+/**
+ * @brief Time between two update passes while idle (ms)
+ */
+#define IDLE_PERIOD_MS 1000
+
+/**
+ * @brief Values that can be watched for changes
+ */
+#define IDLE_PROBES 8
+
+/**
+ * @brief Reads a value shown on screen, e.g. a heading
+ */
+typedef Callback<double()> IdleProbe;
+
+/**
+ * @brief Counters from IdlePolicy::getStats()
+ */
+struct IdleStats
+{
+    uint32_t activeMs;      // time spent active since reset()
+    uint32_t idleMs;        // time spent idle since reset()
+    uint32_t slept;         // times idle was entered
+    uint32_t woken;         // times idle was left
+    uint32_t skipped;       // update and monitor passes not run while idle
+};
+
+/*-----------------------------------------------------------------------------
+ * IDLE POLICY CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class IdlePolicy
+ * @brief Slows the menu down while the Brain is left alone
+ *
+ * Once nothing has touched the screen, called activity() or moved a
+ * watched value for the timeout, the Monitor() loop and every update task
+ * wait IDLE_PERIOD_MS between passes instead of their usual period. While
+ * idle the Monitor() loop does not step the menu: it only looks for a
+ * touch and reads the watched values.
+ *
+ * Idle waits are cut into slices of the normal period, so a touch, a
+ * watched value or activity() wakes everything within one normal period,
+ * as fast as if it had never been idle.
+ *
+ * @code
+ * IdlePolicy::watch([]() { return gyro1.heading(degrees); }, 1.0);
+ * setStatus("Auton done");                 // calls IdlePolicy::activity()
+ * @endcode
+ */
+class IdlePolicy
+{
+    private:
+        static std::atomic<uint32_t> timeout;
+        static std::atomic<uint32_t> lastActivity;
+        static std::atomic<bool> idle;
+        static std::atomic<uint32_t> modeStart;
+
+        // Monitor task only
+        static IdleProbe probes[IDLE_PROBES];
+        static double thresholds[IDLE_PROBES];
+        static double lastValues[IDLE_PROBES];
+        static std::atomic<int> probeCount;
+
+        static std::atomic<uint32_t> activeMs, idleMs, slept, woken, skipped;
+
+        static void begin(uint32_t now);
+        static void leaveMode(uint32_t now, bool wasIdle);
+    public:
+        /**
+         * @brief Time without activity before going idle
+         * @param ms 0 never goes idle
+         */
+        static void setTimeout(uint32_t ms);
+        static uint32_t getTimeout();
+
+        /**
+         * @brief Something changed: stay active, or wake up now
+         * @note Safe from any task; touches and watched values call it
+         */
+        static void activity();
+
+        /**
+         * @brief Wake when a value moves by more than a threshold
+         * @param probe Read by check(), every normal period even while idle
+         * @param threshold Change that counts as activity
+         * @return false if IDLE_PROBES are watched
+         */
+        static bool watch(IdleProbe probe, double threshold);
+
+        /**
+         * @brief Read the watched values and go idle once the timeout is up
+         * @note Called by MonitorStep() and, while idle, by the Monitor() loop
+         */
+        static void check();
+
+        static bool isIdle();
+
+        /**
+         * @brief Wait before the next pass of a loop
+         *
+         * Waits ms while active. While idle, waits up to IDLE_PERIOD_MS in
+         * slices of ms, calling poll after each slice, and returns as soon
+         * as the policy wakes.
+         *
+         * @param ms The loop's normal period
+         * @param poll Cheap check run each slice while idle, or nullptr
+         */
+        static void pause(uint32_t ms, void (*poll)() = nullptr);
+
+        /**
+         * @brief Forget the watched values and counters, and become active
+         */
+        static void reset();
+
+        /**
+         * @brief Time in each mode, the current one included
+         */
+        static IdleStats getStats();
+};
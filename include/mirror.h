@@ -0,0 +1,131 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       mirror.h                                                  */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Controller Mirror - condensed menu on the controller */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Text rows on the V5 controller screen
+ */
+#define MIRROR_ROWS 3
+
+/**
+ * @brief Characters per controller screen row
+ */
+#define MIRROR_COLUMNS 19
+
+/**
+ * @brief Default minimum gap between two controller writes (ms)
+ *
+ * The controller screen is refreshed over the radio link; writes issued
+ * faster than this are dropped or delay joystick packets.
+ */
+#define MIRROR_WRITE_MS 50
+
+/*-----------------------------------------------------------------------------
+ * MIRROR STATISTICS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Work done by the mirror since start()
+ */
+struct MirrorStats
+{
+    uint32_t requests;      // setLine()/print() calls
+    uint32_t writes;        // controller print calls issued
+    uint32_t cells;         // characters sent in those writes
+};
+
+/*-----------------------------------------------------------------------------
+ * CONTROLLER MIRROR CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class ControllerMirror
+ * @brief Shows a condensed text version of the active screen on the controller
+ *
+ * Interfaces describe themselves in up to MIRROR_ROWS lines (see
+ * Interface::setMirror(); without one, the interface name is shown).
+ * Lines are stored in StatusChannels, so any task can set them without
+ * waiting and the most recent text always wins.
+ *
+ * A background task compares the wanted lines with what the controller
+ * shows and writes at most one row segment per period: only the columns
+ * from the first to the last changed character. Rows are visited round
+ * robin, so a row that changes every update cannot starve the others,
+ * and values that change several times between writes are sent once.
+ *
+ * @code
+ * ControllerMirror::start();               // before Monitor()
+ * ControllerMirror::print(2, "Bat %d%%", Brain.Battery.capacity());
+ * @endcode
+ */
+class ControllerMirror
+{
+    private:
+        static StatusChannel lines[MIRROR_ROWS];
+        static char shown[MIRROR_ROWS][MIRROR_COLUMNS + 1];     // flusher only
+        static int nextRow;
+        static controller* target;
+        static uint32_t period;
+        static std::atomic<bool> running;
+        static std::atomic<uint32_t> requests, writes, cells;
+        static task* flusher;
+
+        static int flushTask();
+    public:
+        /**
+         * @brief Clear the controller screen and start the writer task
+         * @param screen Controller to mirror onto
+         * @param periodMs Minimum gap between writes in ms
+         */
+        static void start(controller& screen = Controller, uint32_t periodMs = MIRROR_WRITE_MS);
+
+        /**
+         * @brief Stop the writer task (the controller keeps its text)
+         */
+        static void stop();
+
+        static bool isRunning();
+
+        /**
+         * @brief Set the text wanted on a row
+         *
+         * Never waits. Longer text is cut at MIRROR_COLUMNS; shorter text
+         * is padded so the rest of the row is erased.
+         *
+         * @param row 0 to MIRROR_ROWS - 1
+         * @param text Row text
+         */
+        static void setLine(int row, const char* text);
+
+        /**
+         * @brief printf-style setLine()
+         */
+        static void print(int row, const char* format, ...);
+
+        /**
+         * @brief Blank every row
+         */
+        static void clear();
+
+        /**
+         * @brief Write the next changed row segment, if any
+         *
+         * Called by the writer task once per period; exposed so host tools
+         * can step the mirror without a task.
+         *
+         * @return true if something was written
+         */
+        static bool step();
+
+        /**
+         * @brief Counters since start()
+         */
+        static MirrorStats getStats();
+};
@@ -0,0 +1,179 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       perf.h                                                    */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Performance Counters - Timing histograms             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Buckets per histogram (4 per power of two, up to ~0.5 s)
+ */
+#define PERF_BUCKETS 72
+
+/**
+ * @brief Maximum number of interfaces with their own draw/update timings
+ */
+#define PERF_MAX_SCREENS 16
+
+/*-----------------------------------------------------------------------------
+ * HISTOGRAM CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class Histogram
+ * @brief Fixed-size histogram of durations in microseconds
+ *
+ * Values are counted in log-linear buckets (4 per power of two), so
+ * percentiles are accurate to within 25% while recording stays a single
+ * atomic increment. The maximum is kept exactly. Values beyond the last
+ * bucket are counted in it.
+ */
+class Histogram
+{
+    private:
+        std::atomic<uint32_t> counts[PERF_BUCKETS];
+        std::atomic<uint32_t> total;
+        std::atomic<uint32_t> peak;
+
+        static int bucketOf(uint32_t value);
+        static uint32_t bucketLimit(int bucket);
+    public:
+        Histogram ();
+
+        /**
+         * @brief Count one sample
+         * @param value Duration in microseconds
+         */
+        void record(uint32_t value);
+
+        /**
+         * @brief Estimate a percentile
+         * @param p Percentile, 0-100
+         * @return uint32_t Upper bound of the bucket holding it (us), 0 if empty
+         */
+        uint32_t percentile(int p) const;
+
+        /**
+         * @brief Largest sample recorded (us)
+         */
+        uint32_t max() const;
+
+        /**
+         * @brief Number of samples recorded
+         */
+        uint32_t count() const;
+
+        /**
+         * @brief Forget all samples
+         */
+        void clear();
+};
+
+/*-----------------------------------------------------------------------------
+ * PERF CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class Perf
+ * @brief UI timing probes shared by the Interface system
+ *
+ * Records, per interface, how long display() and each updateInterface()
+ * pass take, plus the touch-to-present latency (press until the next
+ * screen or action completes) and the Monitor() loop period.
+ *
+ * Disabled by default. While disabled every probe is one relaxed atomic
+ * load, so the instrumentation can stay in competition code. Enable it
+ * from the Perf screen (Util > Z) or with Perf::setEnabled(true).
+ *
+ * @code
+ * uint32_t start = Perf::begin();
+ * drawSomething();
+ * Perf::endDraw(this, "Home", start);
+ * @endcode
+ */
+class Perf
+{
+    public:
+        /**
+         * @brief Timings of one interface
+         */
+        struct Screen
+        {
+            std::atomic<const void*> key;       // Interface address
+            std::atomic<const char*> name;      // Interface name, may be null
+            Histogram draw;                     // display() or snapshot restore
+            Histogram update;                   // one updateInterface() pass
+        };
+    private:
+        static std::atomic<bool> enabled;
+        static std::atomic<uint32_t> touchStart;
+        static std::atomic<uint32_t> lastLoop;
+        static Histogram loop;
+        static Histogram latency;
+        static Screen screens[PERF_MAX_SCREENS];
+
+        static Screen* find(const void* key, const char* name);
+        static uint32_t now();
+    public:
+        /**
+         * @brief Turn recording on or off
+         */
+        static void setEnabled(bool enable);
+        static bool isEnabled();
+
+        /**
+         * @brief Start timing a section
+         * @return uint32_t Start time (us), 0 when recording is disabled
+         */
+        static uint32_t begin();
+
+        /**
+         * @brief Record a draw of an interface started with begin()
+         * @param key Interface address, identifies the histogram
+         * @param name Label shown on the Perf screen (may be null)
+         * @param start Value returned by begin(); 0 records nothing
+         */
+        static void endDraw(const void* key, const char* name, uint32_t start);
+
+        /**
+         * @brief Record one update pass of an interface started with begin()
+         */
+        static void endUpdate(const void* key, const char* name, uint32_t start);
+
+        /**
+         * @brief Mark the start of a touch (called by Interface::reset())
+         */
+        static void touched();
+
+        /**
+         * @brief Mark the response to the last touch as on screen
+         *
+         * Records the touch-to-present latency once per touch; further
+         * calls before the next touch are ignored.
+         */
+        static void presented();
+
+        /**
+         * @brief Mark the start of one Monitor() loop pass
+         */
+        static void loopTick();
+
+        static const Histogram& loopPeriod();
+        static const Histogram& touchLatency();
+
+        /**
+         * @brief Per-interface timings, in first-recorded order
+         * @param i Slot index, 0 to PERF_MAX_SCREENS - 1
+         * @return const Screen* Slot, or nullptr once past the last used one
+         */
+        static const Screen* screen(int i);
+
+        /**
+         * @brief Forget every recorded sample
+         */
+        static void clear();
+};
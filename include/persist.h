@@ -0,0 +1,158 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       persist.h                                                 */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Persisted State - menu state kept across restarts    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief "WLIS" read as a little-endian uint32
+ */
+#define UI_STATE_MAGIC 0x53494C57
+
+/**
+ * @brief Record layout version; records of another version are ignored
+ */
+#define UI_STATE_VERSION 1
+
+/**
+ * @brief SD card file prefix; the two slots are "<prefix>.0" and "<prefix>.1"
+ */
+#define UI_STATE_FILE "wlic_state"
+
+/**
+ * @brief Number of user settings stored in the record
+ */
+#define UI_STATE_SETTINGS 8
+
+/**
+ * @brief Quiet time after the last change before the state is written (ms)
+ */
+#define UI_STATE_SAVE_DELAY 1000
+
+/*-----------------------------------------------------------------------------
+ * STATE RECORD
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief What is written to the SD card, little-endian
+ *
+ * Screens and routines are stored by name rather than index, so a
+ * record survives adding screens or routines to the program.
+ */
+struct UIStateRecord
+{
+    uint32_t magic;                         // UI_STATE_MAGIC
+    uint16_t version;                       // UI_STATE_VERSION
+    uint16_t size;                          // sizeof(UIStateRecord)
+    uint32_t sequence;                      // incremented by every save
+    char screen[16];                        // Interface::getName() of the last screen
+    char routine[24];                       // Auton::getName() of the selected routine
+    uint32_t present;                       // bit i set once settings[i] is stored
+    int32_t settings[UI_STATE_SETTINGS];    // user values
+    uint32_t checksum;                      // FNV-1a over everything above
+};
+
+/*-----------------------------------------------------------------------------
+ * UI STATE CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class UIState
+ * @brief Keeps the last screen, selected routine and user settings on the SD card
+ *
+ * The VEX SD card API cannot rename files, so an atomic replace is made
+ * with two slots instead: each save writes the slot that does not hold
+ * the newest record, with a higher sequence number and a checksum.
+ * load() takes the valid record with the highest sequence, so a write
+ * cut short by a reset or a pulled card leaves the previous state intact.
+ *
+ * MonitorSetup() loads the state, selects the saved routine and opens the
+ * saved screen. MonitorStep() notices screen and routine changes, and
+ * poll() writes them once nothing has changed for UI_STATE_SAVE_DELAY.
+ *
+ * @code
+ * int speed = UIState::getSetting(0, 100);     // 100 until first saved
+ * UIState::setSetting(0, 80);                  // written on the next poll()
+ * @endcode
+ */
+class UIState
+{
+    private:
+        static UIStateRecord record;
+        static std::atomic<int32_t> settings[UI_STATE_SETTINGS];
+        static std::atomic<uint32_t> setMask;       // settings given a value
+        static std::atomic<bool> dirty;
+        static uint32_t changedAt;
+        static bool loaded;
+
+        static uint32_t checksum(const UIStateRecord& r);
+        static bool readSlot(int slot, UIStateRecord& out);
+        static void markDirty();
+    public:
+        /**
+         * @brief Read the newest valid record from the SD card
+         * @return true if one was found; otherwise the state is all defaults
+         */
+        static bool load();
+
+        /**
+         * @brief Write the state now, into the older slot
+         * @return true if the whole record was written
+         */
+        static bool save();
+
+        /**
+         * @brief Save if something changed and UI_STATE_SAVE_DELAY has passed
+         */
+        static void poll();
+
+        /**
+         * @brief Whether load() found a saved record
+         */
+        static bool wasLoaded();
+
+        /**
+         * @brief Remember the current screen (by name)
+         * @note Screen and routine are set from the menu loop only
+         */
+        static void setScreen(const char* name);
+
+        /**
+         * @brief Saved screen name, "" if none
+         */
+        static const char* getScreen();
+
+        /**
+         * @brief Remember the selected routine (by name)
+         */
+        static void setRoutine(const char* name);
+
+        /**
+         * @brief Saved routine name, "" if none
+         */
+        static const char* getRoutine();
+
+        /**
+         * @brief Store a user setting
+         * @param i 0 to UI_STATE_SETTINGS - 1
+         * @param value New value
+         */
+        static void setSetting(int i, int32_t value);
+
+        /**
+         * @brief Read a user setting
+         * @param i 0 to UI_STATE_SETTINGS - 1
+         * @param fallback Returned if the setting was never stored
+         */
+        static int32_t getSetting(int i, int32_t fallback = 0);
+
+        /**
+         * @brief Sequence number of the loaded or last saved record
+         */
+        static uint32_t getSequence();
+};
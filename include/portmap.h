@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       portmap.h                                                 */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Port Map - Live device status of the 21 Smart Ports  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Number of Smart Ports on the V5 Brain
+ */
+#define PORTMAP_PORTS 21
+
+/**
+ * @brief Minimum time between two scans of the ports (ms)
+ */
+#define PORTMAP_POLL_MS 100
+
+/**
+ * @brief Side of one port cell on the Ports screen (pixels)
+ */
+#define PORTMAP_CELL 25
+
+/*-----------------------------------------------------------------------------
+ * PORT STATUS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief What a port cell shows, from the expected and the detected device
+ */
+enum PortStatus
+{
+    PORT_EMPTY   = 0,       // nothing expected, nothing plugged in
+    PORT_OK      = 1,       // the expected device is plugged in
+    PORT_MISSING = 2,       // a device is expected, nothing is plugged in
+    PORT_WRONG   = 3,       // a different kind of device is plugged in
+    PORT_EXTRA   = 4        // a device is plugged in, none is expected
+};
+
+/**
+ * @brief Counters from PortMap::getStats()
+ */
+struct PortMapStats
+{
+    uint32_t scans;         // full scans of the 21 ports
+    uint32_t changes;       // ports whose device changed between scans
+    uint32_t cellsDrawn;    // cells redrawn by draw()
+};
+
+/*-----------------------------------------------------------------------------
+ * PORT MAP CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class PortMap
+ * @brief Which Smart Ports are connected, drawn over the Ports screen
+ *
+ * poll() reads the device type of every port, at most once per
+ * PORTMAP_POLL_MS, and caches it. draw() redraws only the cells whose
+ * status changed since they were last drawn, so an unplugged motor turns
+ * red within one update pass without redrawing the screen. The built-in
+ * Ports interface calls both from its update task (drawPorts()).
+ *
+ * Ports given to expect() are compared with what is plugged in:
+ *
+ *   green   expected device present     red     expected, nothing there
+ *   orange  different device type       blue    plugged in, not expected
+ *
+ * @code
+ * PortMap::expect(L1);         // MonitorSetup() does this for robot-config
+ * PortMap::expect(gyro1);
+ * @endcode
+ */
+class PortMap
+{
+    private:
+        static uint8_t expected[PORTMAP_PORTS];                 // V5_DeviceType
+        static std::atomic<uint8_t> detected[PORTMAP_PORTS];    // V5_DeviceType
+        static uint8_t drawn[PORTMAP_PORTS];                    // PortStatus + 1, 0 = not drawn
+        static uint8_t drawnType[PORTMAP_PORTS];
+        static std::atomic<bool> invalid;
+        static uint32_t lastScan;
+        static bool scanned;
+        static std::atomic<uint32_t> scans, changes, cellsDrawn;
+
+        static void drawCell(int port, PortStatus status, uint8_t type);
+    public:
+        /**
+         * @brief Expect a device of this kind on a port
+         * @param port Zero-based port (PORT1 is 0)
+         * @param type Expected device type, kDeviceTypeNoSensor to clear
+         */
+        static void expect(int port, V5_DeviceType type);
+
+        /**
+         * @brief Expect a motor on its port
+         */
+        static void expect(motor& sensor);
+
+        /**
+         * @brief Expect an inertial sensor on its port
+         */
+        static void expect(inertial& sensor);
+
+        /**
+         * @brief Scan the ports if PORTMAP_POLL_MS has passed since the last scan
+         * @return int Number of ports that changed, -1 if it was too early
+         */
+        static int poll();
+
+        /**
+         * @brief Redraw the cells that changed since they were last drawn
+         *
+         * After invalidate(), also draws the map's backdrop and every cell.
+         * Draws with Brain.Screen directly, from the update task.
+         *
+         * @return int Number of cells drawn
+         */
+        static int draw();
+
+        /**
+         * @brief Forget what is on screen, so the next draw() redraws it all
+         * @note Called by displayPorts() whenever the screen is shown
+         */
+        static void invalidate();
+
+        /**
+         * @brief Status of a port from the last scan
+         * @param port Zero-based port
+         */
+        static PortStatus getStatus(int port);
+
+        /**
+         * @brief Device type on a port at the last scan
+         * @param port Zero-based port
+         */
+        static V5_DeviceType getType(int port);
+
+        /**
+         * @brief Short name of a device type, e.g. "MTR", "IMU"
+         */
+        static const char* typeName(uint8_t type);
+
+        static PortMapStats getStats();
+};
@@ -0,0 +1,161 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       recorder.h                                                */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Input Recorder - Touch and sensor session logs       */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Records kept in memory (12 bytes each)
+ */
+#define INPUT_LOG_CAPACITY 4096
+
+/**
+ * @brief Maximum number of watched sensors (motors + inertials)
+ */
+#define INPUT_MAX_WATCHED 16
+
+/**
+ * @brief First four bytes of a saved log
+ */
+#define INPUT_LOG_MAGIC 0x52494C57      // "WLIR"
+#define INPUT_LOG_VERSION 1
+
+/*-----------------------------------------------------------------------------
+ * LOG FORMAT
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Kind of event stored in an InputRecord
+ */
+enum InputType
+{
+    INPUT_TOUCH_PRESS   = 1,    // x, y: position when Interface::reset() saw the press
+    INPUT_TOUCH_RELEASE = 2,    // x, y: position read after the release
+    INPUT_HEADING       = 3,    // port, value: inertial heading, 0.1 degree
+    INPUT_MOTOR_TEMP    = 4,    // port, value: motor temperature, 0.1 C
+    INPUT_MOTOR_VOLT    = 5     // port, value: motor voltage, mV
+};
+
+/**
+ * @brief One timestamped input event
+ *
+ * Saved logs are an InputLogHeader followed by `count` records, both
+ * little-endian (the V5 Brain and x86 hosts read them directly).
+ */
+struct InputRecord
+{
+    uint32_t time;      // ms since InputRecorder::start()
+    uint8_t type;       // InputType
+    uint8_t port;       // zero-based device port (sensor events)
+    int16_t x;          // touch x
+    int16_t y;          // touch y
+    int16_t value;      // sensor reading, fixed point per InputType
+};
+
+struct InputLogHeader
+{
+    uint32_t magic;         // INPUT_LOG_MAGIC
+    uint16_t version;       // INPUT_LOG_VERSION
+    uint16_t recordSize;    // sizeof(InputRecord)
+    uint32_t count;         // number of records that follow
+};
+
+/*-----------------------------------------------------------------------------
+ * INPUT RECORDER CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class InputRecorder
+ * @brief Captures what the menu saw, so a session can be replayed on a PC
+ *
+ * Touches are recorded by Interface::reset() exactly as the Interface
+ * system observed them. Watched sensors are sampled by a background task
+ * and logged only when their value changes. Records go into a fixed
+ * in-memory buffer (recording stops when it is full) and are written to
+ * the SD card with save().
+ *
+ * Replay the file on a PC with `wlic-host replay <file>` (see the Host
+ * Simulator section of the API reference).
+ *
+ * @code
+ * InputRecorder::watch(gyro1);
+ * InputRecorder::watch(L1);
+ * InputRecorder::start();
+ * ...
+ * InputRecorder::stop();
+ * InputRecorder::save("session.wlir");
+ * @endcode
+ */
+class InputRecorder
+{
+    private:
+        struct Watched
+        {
+            device* sensor;
+            bool isMotor;
+            int16_t last[2];    // heading or temperature, voltage
+        };
+
+        static InputRecord records[INPUT_LOG_CAPACITY];
+        static std::atomic<uint32_t> count;
+        static std::atomic<bool> recording;
+        static uint32_t startTime;
+        static uint32_t samplePeriod;
+        static Watched watched[INPUT_MAX_WATCHED];
+        static int watchedCount;
+        static task* sampler;
+
+        static void append(uint8_t type, uint8_t port, int16_t x, int16_t y, int16_t value);
+        static void sample(Watched& w, bool force);
+        static int sampleTask();
+    public:
+        /**
+         * @brief Log an inertial sensor's heading
+         */
+        static bool watch(inertial& sensor);
+
+        /**
+         * @brief Log a motor's temperature and voltage
+         */
+        static bool watch(motor& sensor);
+
+        /**
+         * @brief Clear the buffer and start recording
+         * @param periodMs Sensor sampling period in ms
+         */
+        static void start(uint32_t periodMs = 50);
+
+        /**
+         * @brief Stop recording and the sampling task
+         */
+        static void stop();
+
+        static bool isRecording();
+
+        /**
+         * @brief Record a touch edge (called by Interface::reset())
+         */
+        static void touch(bool pressed, int x, int y);
+
+        /**
+         * @brief Number of records in the buffer
+         */
+        static int size();
+
+        /**
+         * @brief Record i of the buffer, or nullptr if out of range
+         */
+        static const InputRecord* get(int i);
+
+        /**
+         * @brief Write the buffer to the SD card
+         * @param filename File on the SD card
+         * @return true if the whole log was written
+         */
+        static bool save(const char* filename);
+};
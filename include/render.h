@@ -0,0 +1,355 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       render.h                                                  */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Rendering - RLE images, capture and command buffer   */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/*-----------------------------------------------------------------------------
+ * SCREEN GEOMETRY
+ *---------------------------------------------------------------------------*/
+
+#define SCREEN_WIDTH  480     // Drawable width of the V5 Brain screen
+#define SCREEN_HEIGHT 240     // Drawable height of the V5 Brain screen
+
+/**
+ * @brief Size in bytes of one full-screen 0x00RRGGBB frame
+ */
+#define FRAME_BYTES (SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint32_t))
+
+/*-----------------------------------------------------------------------------
+ * COLOR HELPERS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Convert a "#rrggbb" hex string to a 0x00RRGGBB pixel value
+ * @param hex Color string as produced by the VEX Image Converter
+ * @return uint32_t Packed pixel, 0 (black) if the string is malformed
+ */
+uint32_t parseColor(const char* hex);
+
+/*-----------------------------------------------------------------------------
+ * RLE IMAGES
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Draw a Run-Length Encoded full-screen image
+ *
+ * Decodes the three tables produced by the VEX Image Converter. Runs with
+ * a negative color index are transparent and only advance the cursor.
+ * Runs wrap to the next row at SCREEN_WIDTH.
+ *
+ * @param colors Palette of "#rrggbb" strings
+ * @param indices Palette index of each run (negative = skip)
+ * @param counts Pixel count of each run
+ * @param runs Number of runs in indices/counts
+ *
+ * Each row is decoded into memory with fillPixels(), then drawn with one
+ * drawImageFromBuffer() call, or one per piece where skip runs split it.
+ *
+ * @note If a capture is in progress (beginCapture()), the decoded pixels
+ *       are also written into the capture frame
+ * @note While a RenderBuffer is recording, runs are recorded into it as
+ *       row spans instead
+ */
+void drawImageRLE(const char* const* colors, const int* indices,
+                  const int* counts, int runs);
+
+/**
+ * @brief Decode the tables of drawImageRLE() into a frame
+ *
+ * Nothing is drawn, e.g. to build a snapshot ahead of time. Skip runs
+ * leave the frame unchanged, and runs past the last row are ignored.
+ *
+ * @param frame SCREEN_WIDTH x SCREEN_HEIGHT pixel buffer
+ * @return int Pixels covered by the runs decoded, skip runs included
+ */
+int expandImageRLE(const char* const* colors, const int* indices,
+                   const int* counts, int runs, uint32_t* frame);
+
+/**
+ * @brief Set count pixels to one color
+ *
+ * The run expander behind drawImageRLE(), expandImageRLE() and frame
+ * capture. Stores 4 pixels at a time with NEON on the Brain and SSE2 on
+ * x86 hosts, with a scalar loop for the rest and on other targets.
+ *
+ * @param pixels First pixel, any alignment
+ * @param rgb 0x00RRGGBB color
+ * @param count Pixels to set; nothing happens if it is 0 or less
+ */
+void fillPixels(uint32_t* pixels, uint32_t rgb, int count);
+
+/**
+ * @brief Draw one horizontal run of a single color
+ *
+ * The building block for image decoders other than drawImageRLE() (see
+ * asset.h). Like drawImageRLE(), the run is written into the capture
+ * frame if one is active and recorded into the RenderBuffer if one is
+ * recording; otherwise it is drawn as a single line.
+ *
+ * @param rgb 0x00RRGGBB color
+ * @param x First pixel, screen coordinates
+ * @param y Row, screen coordinates
+ * @param length Pixels in the run
+ */
+void drawImageSpan(uint32_t rgb, int x, int y, int length);
+
+/**
+ * @brief Draw a solid rectangle of a single color
+ *
+ * Like drawImageSpan(), but one rectangle instead of a line per row (see
+ * glyph.h). Sets both the pen and the fill color.
+ *
+ * @param rgb 0x00RRGGBB color
+ * @param x Left edge, screen coordinates
+ * @param y Top edge, screen coordinates
+ * @param width Pixels across
+ * @param height Rows
+ */
+void drawImageBlock(uint32_t rgb, int x, int y, int width, int height);
+
+/*-----------------------------------------------------------------------------
+ * FRAME CAPTURE
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Start mirroring library drawing into an off-screen frame
+ *
+ * The frame is cleared to black (matching Brain.Screen.clearScreen()).
+ * Only drawing done through this module (drawImageRLE()) is captured;
+ * direct Brain.Screen calls are not.
+ *
+ * @param frame SCREEN_WIDTH x SCREEN_HEIGHT pixel buffer
+ */
+void beginCapture(uint32_t* frame);
+
+/**
+ * @brief Stop mirroring drawing into the capture frame
+ * @return uint32_t* The frame passed to beginCapture(), or nullptr if none
+ */
+uint32_t* endCapture();
+
+/**
+ * @brief Present a full-screen frame with a single blit
+ * @param frame SCREEN_WIDTH x SCREEN_HEIGHT pixel buffer
+ */
+void drawFrame(uint32_t* frame);
+
+/**
+ * @brief Keep a frame up to date with everything this module draws
+ *
+ * Unlike a capture, tracking stays on across screens: drawImageRLE(),
+ * drawImageSpan() and drawFrame() all write into the frame, and each
+ * beginCapture() (every Interface::Display()) clears it, as the screen
+ * is cleared before a new interface is shown. The Brain cannot read its
+ * screen back, so this is what Screenshot saves. Direct Brain.Screen
+ * drawing (text, shapes) is not tracked.
+ *
+ * @param frame SCREEN_WIDTH x SCREEN_HEIGHT pixel buffer, nullptr to stop
+ */
+void setTrackedFrame(uint32_t* frame);
+
+/**
+ * @brief Frame given to setTrackedFrame(), or nullptr
+ */
+const uint32_t* getTrackedFrame();
+
+/**
+ * @brief Changes each time the whole screen is drawn again
+ *
+ * Bumped by beginCapture() (every Interface::Display()) and drawFrame()
+ * (a snapshot restored by Back), so an update task can tell that what it
+ * drew earlier is gone, e.g. GlyphText.
+ */
+uint32_t getScreenGeneration();
+
+/*-----------------------------------------------------------------------------
+ * COMMAND BUFFER
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Default RenderBuffer capacity in commands (20 bytes each)
+ */
+#define RENDER_BUFFER_COMMANDS 8192
+
+/**
+ * @brief Bytes of text a RenderBuffer can hold between flushes
+ */
+#define RENDER_TEXT_POOL 1024
+
+/**
+ * @brief Flag bit marking a transparent color in RenderCommand::pen/fill
+ */
+#define RENDER_TRANSPARENT 0x01000000
+
+/**
+ * @brief Pen/fill value before the buffer's first setPenColor/setFillColor
+ *        (keeps whatever Brain.Screen already uses)
+ */
+#define RENDER_UNSET 0x80000000
+
+/**
+ * @brief Primitive stored in a RenderCommand
+ */
+enum RenderOp
+{
+    RC_SPAN,        // horizontal run x..x+w-1 on row y, pen color (width 1)
+    RC_LINE,        // (x, y) to (w, h), pen color and width
+    RC_RECT,        // x, y, w, h, pen outline and fill
+    RC_CIRCLE,      // center x, y, radius w, pen outline and fill
+    RC_TEXT,        // printAt(x, y), font + 1 in `width`, fill background
+    RC_CLEAR,       // clearScreen(fill)
+    RC_ORIGIN       // setOrigin(x, y); never reordered
+};
+
+/**
+ * @brief One recorded drawing command with the pen state it needs
+ */
+struct RenderCommand
+{
+    uint8_t op;             // RenderOp
+    uint8_t width;          // pen width, or font + 1 for RC_TEXT (0 = unset)
+    uint16_t text;          // offset into the text pool (RC_TEXT)
+    int16_t x, y, w, h;     // geometry, see RenderOp
+    uint32_t pen;           // 0x00RRGGBB | RENDER_TRANSPARENT
+    uint32_t fill;          // 0x00RRGGBB | RENDER_TRANSPARENT
+};
+
+/**
+ * @brief What a RenderBuffer saved, accumulated since begin()
+ */
+struct RenderStats
+{
+    uint32_t commands;          // primitives recorded
+    uint32_t merged;            // spans joined onto a neighbouring span
+    uint32_t dropped;           // commands fully covered by a later one
+    uint32_t stateRecorded;     // pen/fill/width/font changes asked for
+    uint32_t stateIssued;       // changes actually sent to Brain.Screen
+    uint32_t drawCalls;         // Brain.Screen draw calls issued
+};
+
+/**
+ * @class RenderBuffer
+ * @brief Records drawing, optimizes it, then replays it on Brain.Screen
+ *
+ * Between begin() and end(), the drawing methods (and drawImageRLE(),
+ * which records each run as row spans) are stored instead of drawn.
+ * end() then:
+ *
+ *  - drops commands whose area a later opaque rectangle or clear fully
+ *    covers,
+ *  - groups commands by pen state wherever they do not overlap, so
+ *    each color is set once per group rather than once per primitive,
+ *  - joins touching spans of the same color and draws spans as lines,
+ *  - replays the result, skipping redundant state changes.
+ *
+ * Overlapping commands keep their order, so the picture is unchanged.
+ * A full buffer is flushed early and recording continues. Spans are
+ * drawn with a pen width of 1, which is also left set afterwards if the
+ * caller never chose a width.
+ *
+ * Outside begin()/end() the methods draw immediately. While recording,
+ * draw only through the buffer: direct Brain.Screen calls would land
+ * before the buffered ones. Cursor-based print() is not supported; use
+ * printAt().
+ */
+class RenderBuffer
+{
+    private:
+        struct Box { int x1, y1, x2, y2; };
+        struct GroupKey { uint32_t pen, fill; int extra, kind, slot; };
+
+        RenderCommand* commands;
+        uint16_t* order;            // replay order of one segment
+        uint16_t* group;            // pen-state group of each command
+        uint32_t* coverage;         // one bit per screen pixel
+        GroupKey* keys;             // pen states seen in the current segment
+        uint16_t* slots;            // hash table over keys, index + 1
+        int* starts;                // counting-sort offsets per group
+        int capacity;
+        int count;
+        char text[RENDER_TEXT_POOL];
+        int textUsed;
+        bool recording;
+        RenderStats stats;
+
+        // state as recorded (what the caller asked for)
+        uint32_t pen, fill;
+        int penWidth, font;
+        int originX, originY;       // current recorded origin
+        int batchOriginX, batchOriginY;     // origin when the batch began
+
+        // Brain.Screen state during replay, RENDER_UNSET when unknown
+        uint32_t screenPen, screenFill;
+        int screenWidth, screenFont;
+
+        // span waiting to be joined with the next one
+        RenderCommand pending;
+        bool hasPending;
+
+        RenderCommand* push(uint8_t op);
+        Box bounds(const RenderCommand& c) const;
+        bool covers(const RenderCommand& c, Box& box) const;
+        bool testAndMark(const Box& b);
+        void dropCovered();
+        void emitSegment(int begin, int end);
+        void draw(const RenderCommand& c);
+        void drawNow(const RenderCommand& c);
+        void flush();
+
+        void applyPen(uint32_t value);
+        void applyFill(uint32_t value);
+        void applyWidth(int value);
+        void applyFont(int value);
+    public:
+        /**
+         * @brief Allocate a buffer
+         * @param capacity Commands held before an early flush (max 65535)
+         * @note If the allocation fails the buffer draws immediately
+         */
+        RenderBuffer (int capacity = RENDER_BUFFER_COMMANDS);
+        ~RenderBuffer ();
+
+        /**
+         * @brief Start recording, and route drawImageRLE() into this buffer
+         */
+        void begin();
+
+        /**
+         * @brief Optimize and draw everything recorded, stop recording
+         * @return RenderStats Counters for the commands since begin()
+         */
+        RenderStats end();
+
+        /**
+         * @brief Whether begin() has been called without end()
+         */
+        bool isRecording() const;
+
+        /**
+         * @brief Counters of the last begin()/end() pair
+         */
+        RenderStats getStats() const;
+
+        void setPenColor(const char* hex);
+        void setPenColor(uint32_t rgb);
+        void setFillColor(const char* hex);
+        void setFillColor(uint32_t rgb);
+        void setTransparentFill();
+        void setPenWidth(uint32_t width);
+        void setFont(fontType f);
+        void setOrigin(int x, int y);
+
+        void drawPixel(int x, int y);
+        void drawSpan(int x, int y, int length);
+        void drawLine(int x1, int y1, int x2, int y2);
+        void drawRectangle(int x, int y, int width, int height);
+        void drawCircle(int x, int y, int radius);
+        void printAt(int x, int y, const char* format, ...);
+        void clearScreen(uint32_t rgb = 0);
+};
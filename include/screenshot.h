@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       screenshot.h                                              */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Screenshots - Frames saved to the SD card            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Rows encoded per step of the background encoder
+ */
+#define SCREENSHOT_SLICE_ROWS 16
+
+/**
+ * @brief Pause between two steps of the encoder (ms)
+ */
+#define SCREENSHOT_SLICE_MS 2
+
+/**
+ * @brief Priority of the encoder task (VEX tasks run 1 to 15, default 7)
+ */
+#define SCREENSHOT_PRIORITY 1
+
+/**
+ * @brief Where a screenshot comes from: fills a SCREEN_WIDTH x SCREEN_HEIGHT frame
+ * @return false if there is nothing to save
+ */
+typedef bool (*FrameSource)(uint32_t* frame);
+
+/**
+ * @brief Counters from Screenshot::getStats()
+ */
+struct ScreenshotStats
+{
+    uint32_t taken;         // take() calls that started a screenshot
+    uint32_t written;       // screenshots completely written
+    uint32_t failed;        // screenshots whose file could not be written
+    uint32_t lastBytes;     // file size of the last written screenshot
+    uint32_t lastMs;        // time from take() to the file being closed
+};
+
+/*-----------------------------------------------------------------------------
+ * SCREENSHOT CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class Screenshot
+ * @brief Saves what the Brain shows as an asset file on the SD card
+ *
+ * take() only copies the current frame and returns. A low-priority task
+ * then RLE-encodes the copy SCREENSHOT_SLICE_ROWS rows at a time,
+ * pausing between slices, and writes it in the asset format (asset.h),
+ * so the menu and driver code keep running while it is saved.
+ *
+ * The Brain cannot read its screen back, so the frame comes from the
+ * tracked framebuffer (setTrackedFrame() in render.h), which follows
+ * every image drawn by the library but not direct Brain.Screen text or
+ * shapes. track(true) allocates it. The host simulator, which has the
+ * real framebuffer, installs its own source with setSource().
+ *
+ * View a screenshot on a PC with `wlic-host unpack shot.wlia shot.ppm`.
+ *
+ * @code
+ * Screenshot::track(true);                                    // in pre_auton()
+ * Controller.ButtonX.pressed([]() { Screenshot::take("shot1.wlia"); });
+ * @endcode
+ */
+class Screenshot
+{
+    private:
+        static uint32_t* tracked;
+        static uint32_t* pending;           // copy being encoded
+        static char filename[32];
+        static FrameSource source;
+        static std::atomic<bool> busy;
+        static uint32_t startTime;
+        static std::atomic<uint32_t> taken, written, failed, lastBytes, lastMs;
+        static task* encoder;
+
+        static bool trackedSource(uint32_t* frame);
+        static int encodeTask();
+    public:
+        /**
+         * @brief Start or stop tracking library drawing for screenshots
+         * @param enable true to allocate the tracked frame (FRAME_BYTES)
+         * @return false if the frame could not be allocated
+         */
+        static bool track(bool enable);
+
+        static bool isTracking();
+
+        /**
+         * @brief Take frames from somewhere else than the tracked frame
+         * @param frameSource Source, or nullptr for the tracked frame
+         */
+        static void setSource(FrameSource frameSource);
+
+        /**
+         * @brief Copy the current frame and save it in the background
+         * @param file File on the SD card (replaced if it exists)
+         * @return false if a screenshot is still being saved, there is no
+         *         frame or SD card, or no memory for the copy
+         */
+        static bool take(const char* file);
+
+        /**
+         * @brief Whether a screenshot is still being encoded or written
+         */
+        static bool isBusy();
+
+        static ScreenshotStats getStats();
+};
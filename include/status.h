@@ -0,0 +1,138 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       status.h                                                  */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Status Channel - Lock-free status message            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Maximum status length in characters, including the terminator
+ */
+#define STATUS_LENGTH 32
+
+/**
+ * @brief Number of status transitions kept by the optional history
+ */
+#define STATUS_HISTORY_LENGTH 8
+
+/*-----------------------------------------------------------------------------
+ * STATUS ENTRY
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief One recorded status transition
+ */
+struct StatusEntry
+{
+    uint32_t time;                  // Brain timer (ms) when the status was set
+    char text[STATUS_LENGTH];       // Status text, always null-terminated
+};
+
+/*-----------------------------------------------------------------------------
+ * STATUS CHANNEL CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class StatusChannel
+ * @brief Fixed-capacity status message shared between tasks
+ *
+ * A sequence lock over a fixed character buffer: writers (autonomous,
+ * usercontrol) never allocate and never wait, and readers (the Home
+ * screen update task) retry instead of seeing a half-written message. A
+ * writer that finds another one mid-write leaves its text in a one-slot
+ * mailbox instead, which the writer holding the channel publishes before
+ * it leaves, so the newest text wins. Text is stored in atomic words so the channel is also free of
+ * data races when tasks run on real threads (host builds).
+ *
+ * @code
+ * setStatus(Status_Moving);               // from autonomous
+ *
+ * char text[STATUS_LENGTH];
+ * status.get(text, sizeof(text));         // from the display task
+ * @endcode
+ */
+class StatusChannel
+{
+    private:
+        static const int WORDS = STATUS_LENGTH / 4;
+
+        struct Slot
+        {
+            std::atomic<uint32_t> time;
+            std::atomic<uint32_t> words[WORDS];
+        };
+
+        /**
+         * @brief Sequence counter, odd while a write is in progress
+         */
+        std::atomic<uint32_t> sequence;
+
+        /**
+         * @brief Current status text
+         */
+        std::atomic<uint32_t> words[WORDS];
+
+        /**
+         * @brief Text left by a writer that lost the race, newest only
+         */
+        enum { PENDING_EMPTY, PENDING_WRITING, PENDING_FULL };
+        std::atomic<uint32_t> pendingState;
+        std::atomic<uint32_t> pending[WORDS];
+
+        /**
+         * @brief Ring of recent transitions, oldest overwritten first
+         */
+        Slot history[STATUS_HISTORY_LENGTH];
+        std::atomic<uint32_t> historyCount;
+        std::atomic<bool> historyEnabled;
+
+        static void pack(std::atomic<uint32_t>* dst, const char* text);
+        static void unpack(char* dst, const std::atomic<uint32_t>* src);
+        bool claim(uint32_t& seq);
+        void publish(const char* text);
+    public:
+        /**
+         * @brief Create a channel holding an initial status
+         * @param initial Initial status text
+         */
+        StatusChannel (const char* initial);
+
+        /**
+         * @brief Publish a new status
+         *
+         * Copies at most STATUS_LENGTH - 1 characters. Never allocates and
+         * never waits: while another task is mid-write, the text is handed
+         * to it and published when it finishes. Of three writers racing at
+         * once, the last may be dropped.
+         *
+         * @param text New status text
+         */
+        void set(const char* text);
+
+        /**
+         * @brief Read the latest status
+         *
+         * @param out Destination buffer
+         * @param size Size of out in bytes (STATUS_LENGTH holds any status)
+         */
+        void get(char* out, int size) const;
+
+        /**
+         * @brief Turn the transition history on or off
+         * @param enable true to record every set() with a timestamp
+         */
+        void setHistoryEnabled(bool enable);
+
+        /**
+         * @brief Copy the recorded transitions, oldest first
+         *
+         * @param out Destination array
+         * @param max Capacity of out
+         * @return int Number of entries copied
+         */
+        int getHistory(StatusEntry* out, int max) const;
+};
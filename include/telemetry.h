@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       telemetry.h                                               */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Telemetry - binary match logs on the SD card         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Records held in memory between flushes (a power of two, 8 bytes each)
+ */
+#define TELEMETRY_RING_RECORDS 1024
+
+/**
+ * @brief Bytes appended to the SD card per write (a multiple of the record size)
+ */
+#define TELEMETRY_BLOCK_BYTES 4096
+
+/**
+ * @brief A partly filled block is written after this long (ms)
+ */
+#define TELEMETRY_FLUSH_MS 1000
+
+/**
+ * @brief How often the flusher empties the ring (ms)
+ */
+#define TELEMETRY_DRAIN_MS 20
+
+/**
+ * @brief Priority of the flusher task (VEX tasks run 1 to 15, default 7)
+ */
+#define TELEMETRY_FLUSH_PRIORITY 1
+
+/**
+ * @brief Maximum number of watched sensors (motors + inertials)
+ */
+#define TELEMETRY_MAX_WATCHED 16
+
+/**
+ * @brief First four bytes of a log, "WLIT"
+ */
+#define TELEMETRY_MAGIC 0x54494C57
+#define TELEMETRY_VERSION 1
+
+/*-----------------------------------------------------------------------------
+ * LOG FORMAT
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Kind of value stored in a TelemetryRecord
+ */
+enum TelemetryType
+{
+    TELEMETRY_MOTOR_TEMP = 1,   // motor temperature, 0.1 C
+    TELEMETRY_MOTOR_VOLT = 2,   // motor voltage, mV
+    TELEMETRY_HEADING    = 3,   // inertial heading, 0.1 degree
+    TELEMETRY_USER       = 16   // and above: Telemetry::log() values, unscaled
+};
+
+/**
+ * @brief One timestamped value
+ *
+ * A log is a TelemetryHeader followed by records until the end of the
+ * file, both little-endian (the V5 Brain and x86 hosts read them directly).
+ * There is no record count, so a log cut short by a reset is still readable.
+ */
+struct TelemetryRecord
+{
+    uint32_t time;      // ms since Telemetry::start()
+    uint8_t type;       // TelemetryType
+    uint8_t port;       // zero-based device port, or a user channel
+    int16_t value;      // fixed point per TelemetryType
+};
+
+struct TelemetryHeader
+{
+    uint32_t magic;         // TELEMETRY_MAGIC
+    uint16_t version;       // TELEMETRY_VERSION
+    uint16_t recordSize;    // sizeof(TelemetryRecord)
+    uint32_t startTime;     // timer::system() when the log was started
+};
+
+/**
+ * @brief Counters from Telemetry::getStats(), since start()
+ */
+struct TelemetryStats
+{
+    uint32_t logged;        // records accepted into the ring
+    uint32_t dropped;       // records refused because the ring was full
+    uint32_t written;       // records written to the SD card
+    uint32_t lost;          // records taken from the ring but not written
+    uint32_t blocks;        // SD card writes
+};
+
+/*-----------------------------------------------------------------------------
+ * TELEMETRY CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class Telemetry
+ * @brief Logs sensor values to the SD card without printf on the hot path
+ *
+ * log() stores a fixed 8-byte record in a lock-free ring and returns; any
+ * task may call it. A low-priority flusher task moves the ring into a
+ * TELEMETRY_BLOCK_BYTES block and appends whole blocks to the log file,
+ * so the SD card sees a few large writes instead of one per value. When
+ * the ring is full new records are dropped and counted, never blocked on.
+ *
+ * Watched motors and inertial sensors are sampled every period by a
+ * background task. Convert a log to CSV on a PC with
+ * `wlic-host telemetry2csv <file>`.
+ *
+ * @code
+ * Telemetry::watch(L1);
+ * Telemetry::watch(gyro1);
+ * Telemetry::start("match.wlit", 50);
+ * Telemetry::log(TELEMETRY_USER, 0, intakeState);
+ * ...
+ * Telemetry::stop();       // writes what is left
+ * @endcode
+ */
+class Telemetry
+{
+    private:
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence;     // ring position this slot is ready for
+            TelemetryRecord record;
+        };
+        struct Watched
+        {
+            device* sensor;
+            bool isMotor;
+        };
+
+        static Slot ring[TELEMETRY_RING_RECORDS];
+        static std::atomic<uint32_t> head;      // next position to claim
+        static uint32_t tail;                   // next position to read (flusher only)
+        static uint8_t block[TELEMETRY_BLOCK_BYTES];
+        static int blockUsed;
+        static uint32_t blockStarted;
+        static char filename[32];
+        static uint32_t startTime;
+        static uint32_t samplePeriod;
+        static Watched watched[TELEMETRY_MAX_WATCHED];
+        static int watchedCount;
+        static std::atomic<bool> running;
+        static std::atomic<uint32_t> logged, dropped, written, lost, blocks;
+        static task* sampler;
+        static task* flusher;
+
+        static void drain();
+        static void writeBlock();
+        static int sampleTask();
+        static int flushTask();
+    public:
+        /**
+         * @brief Sample a motor's temperature and voltage
+         */
+        static bool watch(motor& sensor);
+
+        /**
+         * @brief Sample an inertial sensor's heading
+         */
+        static bool watch(inertial& sensor);
+
+        /**
+         * @brief Create the log file and start the sampler and flusher
+         * @param file File on the SD card (replaced if it exists)
+         * @param periodMs Sampling period for watched sensors
+         * @return false if there is no SD card or the file cannot be written
+         */
+        static bool start(const char* file, uint32_t periodMs = 50);
+
+        /**
+         * @brief Stop sampling and write everything still buffered
+         */
+        static void stop();
+
+        static bool isRunning();
+
+        /**
+         * @brief Add one record; safe from any task, never waits
+         * @param type TelemetryType, TELEMETRY_USER or above for your own values
+         * @param port Device port or channel number
+         * @param value Value in the type's units
+         * @return false if not running or the ring is full (counted as dropped)
+         */
+        static bool log(uint8_t type, uint8_t port, int16_t value);
+
+        static TelemetryStats getStats();
+};
@@ -1,14 +1,34 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 #include <string>  // C++ string class (std::string)
 #include <vector>  // C++ vector class (std::vector)
+#include <atomic>  // C++ atomics (std::atomic)
 
 #include "v5.h"
 #include "v5_vcs.h"
 
 #include "robot-config.h"
+#include "callback.h"
+#include "heap.h"
+#include "render.h"
+#include "glyph.h"
+#include "asset.h"
+#include "screenshot.h"
+#include "status.h"
+#include "perf.h"
+#include "watchdog.h"
+#include "recorder.h"
+#include "telemetry.h"
+#include "mirror.h"
+#include "persist.h"
+#include "portmap.h"
+#include "fieldmap.h"
+#include "health.h"
+#include "idle.h"
 #include "WLIC.h"
 #include "display.h"
 
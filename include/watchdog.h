@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       watchdog.h                                                */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  WLIC Budget Watchdog - Callback time budgets              */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/**
+ * @brief Default time budget of every callback of an interface (us)
+ */
+#define WATCHDOG_DEFAULT_BUDGET 50000
+
+/**
+ * @brief Most recent overruns kept for inspection
+ */
+#define WATCHDOG_LOG_SIZE 16
+
+/**
+ * @brief Consecutive update overruns before a throttled screen backs off
+ */
+#define WATCHDOG_STRIKES 3
+
+/**
+ * @brief Largest update period multiplier of a throttled screen
+ */
+#define WATCHDOG_MAX_BACKOFF 8
+
+/*-----------------------------------------------------------------------------
+ * OVERRUN RECORD
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Which Interface callback overran
+ */
+enum CallbackKind
+{
+    CALLBACK_DISPLAY = 0,       // display(), from Display()
+    CALLBACK_UPDATE  = 1,       // one updateInterface() pass
+    CALLBACK_ACTION  = 2        // actions(button), from Action()
+};
+
+/**
+ * @brief What an interface does when its update passes keep overrunning
+ */
+enum BudgetPolicy
+{
+    BUDGET_REPORT   = 0,        // only record the overruns
+    BUDGET_THROTTLE = 1         // also stretch the update period (skip passes)
+};
+
+/**
+ * @brief One callback that took longer than its budget
+ */
+struct Overrun
+{
+    const void* key;            // Interface address
+    const char* name;           // Interface name, may be null
+    uint8_t callback;           // CallbackKind
+    uint32_t elapsed;           // how long it took (us)
+    uint32_t budget;            // what it was allowed (us)
+    uint32_t time;              // timer::system() when it ended (ms)
+};
+
+/*-----------------------------------------------------------------------------
+ * WATCHDOG CLASS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @class Watchdog
+ * @brief Times Interface callbacks against their budgets
+ *
+ * Display(), each update pass and Action() are timed with begin()/end()
+ * against the interface's budget (Interface::setBudget()). An overrun is
+ * counted and kept in a small log with the interface and the callback,
+ * so a screen that stalls navigation or the update loop can be found on
+ * the Perf screen instead of guessed at.
+ *
+ * Timing is on by default and costs one clock read per callback; it
+ * does not depend on Perf recording.
+ *
+ * Each log slot carries the number of the overrun it holds, set once the
+ * record is complete, so recent() can copy the log while tasks add to it:
+ * a record caught half-written or replaced during the copy is read again,
+ * and left out if it does not settle.
+ *
+ * @code
+ * Overrun log[WATCHDOG_LOG_SIZE];
+ * int n = Watchdog::recent(log, WATCHDOG_LOG_SIZE);    // newest first
+ * @endcode
+ */
+class Watchdog
+{
+    private:
+        struct Slot
+        {
+            std::atomic<uint32_t> sequence;     // overrun number + 1 once written, 0 while writing
+            Overrun record;
+        };
+
+        static std::atomic<bool> enabled;
+        static std::atomic<uint32_t> total;
+        static std::atomic<uint32_t> next;      // number of the next overrun
+        static Slot log[WATCHDOG_LOG_SIZE];
+    public:
+        /**
+         * @brief Turn budget checks on or off
+         */
+        static void setEnabled(bool enable);
+        static bool isEnabled();
+
+        /**
+         * @brief Start timing a callback
+         * @return uint32_t Start time (us), 0 when disabled
+         */
+        static uint32_t begin();
+
+        /**
+         * @brief Check a callback started with begin() against its budget
+         * @param key Interface address
+         * @param name Interface name (may be null)
+         * @param callback CallbackKind
+         * @param start Value returned by begin(); 0 checks nothing
+         * @param budget Allowed time (us); 0 means unlimited
+         * @return true if the callback overran (and was recorded)
+         */
+        static bool end(const void* key, const char* name, CallbackKind callback,
+                        uint32_t start, uint32_t budget);
+
+        /**
+         * @brief Overruns recorded since the last clear()
+         */
+        static uint32_t overruns();
+
+        /**
+         * @brief Copy the most recent overruns, newest first
+         * @param out Destination array
+         * @param max Size of out
+         * @return int Number of records copied
+         */
+        static int recent(Overrun* out, int max);
+
+        /**
+         * @brief Name of a CallbackKind, e.g. "update"
+         */
+        static const char* callbackName(uint8_t callback);
+
+        /**
+         * @brief Forget every recorded overrun
+         */
+        static void clear();
+};
@@ -0,0 +1,64 @@
+# WLIC host simulator build
+#
+# Compiles the library in src/ (everything except main.cpp) against the
+# software vex:: API in sim/ instead of the VEX SDK, and links the
+# headless driver build/host/wlic-host. Needs only a Linux C++ compiler.
+
+HOST_CXX   ?= g++
+HOST_BUILD  = $(BUILD)/host
+HOST_FLAGS  = -std=gnu++11 -O2 -g -Wall -fno-rtti -fno-exceptions -pthread -DWLIC_HOST -DWLIC_TRACK_MEMORY
+HOST_INC    = -Isim/include -I$(INC_F)
+
+HOST_SRC    = $(filter-out src/main.cpp, $(wildcard src/*.cpp))
+HOST_SRC   += $(wildcard sim/src/*.cpp)
+HOST_OBJ    = $(addprefix $(HOST_BUILD)/, $(addsuffix .o, $(basename $(HOST_SRC))))
+HOST_TOOL   = $(addprefix $(HOST_BUILD)/, $(addsuffix .o, $(basename $(wildcard sim/tool/*.cpp))))
+HOST_H      = $(SRC_H) $(wildcard sim/include/*.h) $(wildcard sim/tool/*.h)
+
+host: $(HOST_BUILD)/wlic-host
+
+# the same tool built with ThreadSanitizer, for wlic-host stress with threads
+HOST_TSAN       = $(BUILD)/host-tsan
+# -Wno-tsan: the seqlocks in status.cpp and fieldmap.cpp use fences, which
+# ThreadSanitizer does not model; stress does not exercise them
+HOST_TSAN_FLAGS = $(HOST_FLAGS) -O1 -fsanitize=thread -Wno-tsan
+HOST_TSAN_OBJ   = $(addprefix $(HOST_TSAN)/, $(addsuffix .o, $(basename $(HOST_SRC) $(wildcard sim/tool/*.cpp))))
+
+host-tsan: $(HOST_TSAN)/wlic-host
+
+# and without WLIC_TRACK_MEMORY, as the Brain builds it by default: nothing
+# replaces operator new, and heap and callback report that they cannot run
+HOST_NOTRACK       = $(BUILD)/host-notrack
+HOST_NOTRACK_FLAGS = $(filter-out -DWLIC_TRACK_MEMORY, $(HOST_FLAGS))
+HOST_NOTRACK_OBJ   = $(addprefix $(HOST_NOTRACK)/, $(addsuffix .o, $(basename $(HOST_SRC) $(wildcard sim/tool/*.cpp))))
+
+host-notrack: $(HOST_NOTRACK)/wlic-host
+
+$(HOST_BUILD)/%.o: %.cpp $(HOST_H) sim/host.mk
+	$(Q)$(MKDIR)
+	$(ECHO) "HOST $<"
+	$(Q)$(HOST_CXX) $(HOST_FLAGS) $(HOST_INC) -c -o $@ $<
+
+$(HOST_BUILD)/wlic-host: $(HOST_OBJ) $(HOST_TOOL)
+	$(ECHO) "LINK $@"
+	$(Q)$(HOST_CXX) $(HOST_FLAGS) -o $@ $^
+
+$(HOST_TSAN)/%.o: %.cpp $(HOST_H) sim/host.mk
+	$(Q)$(MKDIR)
+	$(ECHO) "TSAN $<"
+	$(Q)$(HOST_CXX) $(HOST_TSAN_FLAGS) $(HOST_INC) -c -o $@ $<
+
+$(HOST_TSAN)/wlic-host: $(HOST_TSAN_OBJ)
+	$(ECHO) "LINK $@"
+	$(Q)$(HOST_CXX) $(HOST_TSAN_FLAGS) -o $@ $^
+
+$(HOST_NOTRACK)/%.o: %.cpp $(HOST_H) sim/host.mk
+	$(Q)$(MKDIR)
+	$(ECHO) "HOST $<"
+	$(Q)$(HOST_CXX) $(HOST_NOTRACK_FLAGS) $(HOST_INC) -c -o $@ $<
+
+$(HOST_NOTRACK)/wlic-host: $(HOST_NOTRACK_OBJ)
+	$(ECHO) "LINK $@"
+	$(Q)$(HOST_CXX) $(HOST_NOTRACK_FLAGS) -o $@ $^
+
+.PHONY: host host-tsan host-notrack
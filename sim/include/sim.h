@@ -0,0 +1,184 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       sim.h                                                     */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Host simulator control - framebuffer, touch, devices      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+#include "v5.h"
+
+/*  Host-only API used by the tools in sim/ to drive the WLIC library
+    without a robot. Never include this from src/: the library only talks
+    to the vex:: API, which the simulator implements.  */
+
+namespace sim
+{
+    /*-------------------------------------------------------------------------
+     * FRAMEBUFFER
+     *-----------------------------------------------------------------------*/
+
+    const int WIDTH  = 480;     // Physical V5 screen width
+    const int HEIGHT = 272;     // Physical V5 screen height
+
+    /**
+     * @brief Current screen contents, WIDTH x HEIGHT 0x00RRGGBB pixels
+     */
+    const uint32_t* framebuffer();
+
+    /**
+     * @brief Read one pixel, 0 if out of range
+     */
+    uint32_t pixel(int x, int y);
+
+    /**
+     * @brief Write the framebuffer to a binary PPM (P6) file
+     * @return true on success
+     */
+    bool savePPM(const char* path);
+
+    /**
+     * @brief Write any 0x00RRGGBB buffer to a binary PPM (P6) file
+     * @return true on success
+     */
+    bool savePPM(const char* path, const uint32_t* pixels, int width, int height);
+
+    /**
+     * @brief Clear the screen, pending touches, pen state and draw stats
+     */
+    void reset();
+
+    /*-------------------------------------------------------------------------
+     * DRAW STATISTICS
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Brain.Screen work counted since the last reset
+     */
+    struct DrawStats
+    {
+        uint64_t drawCalls;     // draw*, print*, clearScreen and clearLine calls
+        uint64_t penChanges;    // setPenColor calls
+        uint64_t fillChanges;   // setFillColor calls
+        uint64_t pixels;        // on-screen pixel writes, overdraw included
+    };
+
+    /**
+     * @brief Counters accumulated since the last reset()/resetDrawStats()
+     */
+    DrawStats drawStats();
+
+    /**
+     * @brief Zero the draw counters without touching the screen
+     */
+    void resetDrawStats();
+
+    /*-------------------------------------------------------------------------
+     * TOUCH
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Queue a tap (press then release) at a screen position
+     *
+     * The first Brain.Screen.pressing() call after a tap reports the press,
+     * the next one the release, so Interface::reset() sees exactly one
+     * complete touch without needing a second thread.
+     */
+    void tap(int x, int y);
+
+    /**
+     * @brief Hold the screen pressed at a position until release()
+     */
+    void press(int x, int y);
+
+    /**
+     * @brief Release a press started with press()
+     */
+    void release();
+
+    /*-------------------------------------------------------------------------
+     * TIME AND TASKS
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Scale applied to vex::wait() sleeps
+     *
+     * 1.0 sleeps in real time (default); 0 turns every wait into a yield so
+     * tools can run the menu as fast as possible.
+     */
+    void setTimeScale(double scale);
+
+    /**
+     * @brief Stop every running vex::task and wait for them to exit
+     */
+    void stopAllTasks();
+
+    /**
+     * @brief Number of vex::task threads currently running
+     */
+    int liveTasks();
+
+    /*-------------------------------------------------------------------------
+     * DEVICES
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Plug a device into a port (kDeviceTypeNoSensor unplugs it)
+     * @param port Zero-based port index (vex::PORT1 == 0)
+     */
+    void setDevice(int port, V5_DeviceType type);
+
+    /**
+     * @brief Set the readings reported by a motor
+     */
+    void setMotor(int port, double temperature, double voltage);
+
+    /**
+     * @brief Set the heading reported by an inertial sensor (degrees)
+     */
+    void setHeading(int port, double heading);
+
+    /*-------------------------------------------------------------------------
+     * SD CARD
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Host directory standing in for the Brain's SD card
+     * @param path Directory path (default "sd"); must already exist
+     */
+    void setSDRoot(const char* path);
+
+    /**
+     * @brief Current SD card directory
+     */
+    const char* sdRoot();
+
+    /*-------------------------------------------------------------------------
+     * TEXT
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Last string printed on the Brain screen
+     * @note Text is recorded rather than rasterized; only its background box
+     *       (in the fill color) is drawn into the framebuffer
+     */
+    const char* lastText();
+
+    /*-------------------------------------------------------------------------
+     * CONTROLLER
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Text shown on a controller screen row (0-2), 19 characters
+     */
+    const char* controllerLine(int row);
+
+    /**
+     * @brief Controller screen print/clear calls since start
+     */
+    uint32_t controllerWrites();
+}
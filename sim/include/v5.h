@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       v5.h (host simulator)                                     */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Host stand-in for the VEX SDK C header                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Device types reported by vex::device::type(), as in the VEX SDK
+ */
+typedef enum
+{
+    kDeviceTypeNoSensor        = 0,
+    kDeviceTypeMotorSensor     = 2,
+    kDeviceTypeLedSensor       = 3,
+    kDeviceTypeAbsEncSensor    = 4,
+    kDeviceTypeCrMotorSensor   = 5,
+    kDeviceTypeImuSensor       = 6,
+    kDeviceTypeDistanceSensor  = 7,
+    kDeviceTypeRadioSensor     = 8,
+    kDeviceTypeTetherSensor    = 9,
+    kDeviceTypeBrainSensor     = 10,
+    kDeviceTypeVisionSensor    = 11,
+    kDeviceTypeAdiSensor       = 12,
+    kDeviceTypeOpticalSensor   = 16,
+    kDeviceTypeMagnetSensor    = 17,
+    kDeviceTypeGpsSensor       = 20,
+    kDeviceTypeBumperSensor    = 0x40,
+    kDeviceTypeGenericSensor   = 129,
+    kDeviceTypeUndefinedSensor = 255
+} V5_DeviceType;
+
+/*-----------------------------------------------------------------------------
+ * SD CARD FILES
+ *---------------------------------------------------------------------------*/
+
+/*  Streaming file access from the SDK, for reading and writing in chunks
+    (vex::brain::sdcard only loads or saves whole files). Paths are
+    relative to the SD card; the simulator maps them onto sim::sdRoot(). */
+
+typedef void FIL_T;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FIL_T*  vexFileOpen(const char* filename, const char* mode);
+FIL_T*  vexFileOpenWrite(const char* filename);
+void    vexFileClose(FIL_T* fdp);
+int32_t vexFileRead(char* buf, uint32_t size, uint32_t nItems, FIL_T* fdp);
+int32_t vexFileWrite(char* buf, uint32_t size, uint32_t nItems, FIL_T* fdp);
+int32_t vexFileSize(FIL_T* fdp);
+
+#ifdef __cplusplus
+}
+#endif
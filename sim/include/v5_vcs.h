@@ -0,0 +1,232 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       v5_vcs.h (host simulator)                                 */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Host stand-in for the subset of the VEX C++ API used by   */
+/*                  WLIC, backed by an in-memory framebuffer                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+#include "v5.h"
+
+/*  Only the calls made by this project are provided. Anything drawn on the
+    Brain screen lands in the simulator framebuffer (see sim.h), devices
+    report values set through sim.h, and tasks are real threads.  */
+
+namespace vex
+{
+    /*-------------------------------------------------------------------------
+     * UNITS AND CONSTANTS
+     *-----------------------------------------------------------------------*/
+
+    enum timeUnits { sec, msec };
+    enum voltageUnits { volt, mV };
+    enum temperatureUnits { celsius, fahrenheit };
+    enum rotationUnits { deg, rev, raw };
+    static const rotationUnits degrees = deg;
+    static const rotationUnits turns = rev;
+    enum gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+    enum controllerType { primary, partner };
+    enum fontType { mono20, mono30, mono40, mono60, mono15, mono12,
+                    prop20, prop30, prop40, prop60 };
+
+    enum
+    {
+        PORT1 = 0, PORT2, PORT3, PORT4, PORT5, PORT6, PORT7,
+        PORT8, PORT9, PORT10, PORT11, PORT12, PORT13, PORT14,
+        PORT15, PORT16, PORT17, PORT18, PORT19, PORT20, PORT21
+    };
+
+    /*-------------------------------------------------------------------------
+     * COLOR
+     *-----------------------------------------------------------------------*/
+
+    class color
+    {
+        private:
+            uint32_t value;
+            bool clear;
+        public:
+            color () : value(0), clear(false) {}
+            color (uint32_t rgb) : value(rgb & 0xFFFFFF), clear(false) {}
+            color (int r, int g, int b)
+                : value(((r & 0xFF) << 16) | ((g & 0xFF) << 8) | (b & 0xFF)), clear(false) {}
+            color (const char* hex);
+
+            uint32_t rgb() const { return value; }
+            bool isTransparent() const { return clear; }
+
+            static color makeTransparent();
+    };
+
+    extern const color black, white, red, green, blue, yellow,
+                       orange, purple, cyan, transparent;
+
+    /*-------------------------------------------------------------------------
+     * TIME AND TASKS
+     *-----------------------------------------------------------------------*/
+
+    /**
+     * @brief Sleep the calling task (scaled by sim::setTimeScale())
+     */
+    void wait(double time, timeUnits units);
+
+    class timer
+    {
+        private:
+            uint64_t start;
+        public:
+            timer ();
+            double time(timeUnits units = msec) const;
+            void clear();
+
+            static uint32_t system();
+            static uint64_t systemHighResolution();
+    };
+
+    class task
+    {
+        public:
+            struct state;               // simulator thread bookkeeping
+        private:
+            state* st;
+        public:
+            task (int (*callback)(void*), void* arg);
+            task (int (*callback)());
+            task (int (*callback)(), int32_t priority);     // priority is ignored
+            ~task ();
+
+            /**
+             * @brief Stop the task at its next wait() and wait for it to exit
+             */
+            void stop();
+
+            static void sleep(uint32_t ms);
+            static void yield();
+    };
+
+    /*-------------------------------------------------------------------------
+     * DEVICES
+     *-----------------------------------------------------------------------*/
+
+    class device
+    {
+        protected:
+            int32_t port;
+        public:
+            device (int32_t index) : port(index) {}
+            bool installed();
+            V5_DeviceType type();
+            int32_t index() { return port; }
+    };
+
+    class motor : public device
+    {
+        public:
+            motor (int32_t index, gearSetting gears = ratio18_1, bool reverse = false);
+            double temperature(temperatureUnits units);
+            double voltage(voltageUnits units);
+    };
+
+    class motor_group
+    {
+        private:
+            motor* motors[8];
+            int count;
+            void add(motor& m) { if (count < 8) motors[count++] = &m; }
+            void add() {}
+            template <typename... M>
+            void add(motor& m, M&... rest) { add(m); add(rest...); }
+        public:
+            template <typename... M>
+            motor_group (M&... m) : count(0) { add(m...); }
+            double voltage(voltageUnits units);
+    };
+
+    class inertial : public device
+    {
+        public:
+            inertial (int32_t index);
+            double heading(rotationUnits units = degrees);
+            double rotation(rotationUnits units = degrees);
+    };
+
+    /*-------------------------------------------------------------------------
+     * BRAIN
+     *-----------------------------------------------------------------------*/
+
+    class brain
+    {
+        public:
+            class lcd
+            {
+                public:
+                    void setPenColor(const color& c);
+                    void setPenColor(const char* hex);
+                    void setFillColor(const color& c);
+                    void setFillColor(const char* hex);
+                    void setPenWidth(uint32_t width);
+                    void setOrigin(int32_t x, int32_t y);
+                    void setCursor(int32_t row, int32_t col);
+                    void setFont(fontType font);
+
+                    void drawPixel(int x, int y);
+                    void drawLine(int x1, int y1, int x2, int y2);
+                    void drawRectangle(int x, int y, int width, int height);
+                    void drawCircle(int x, int y, int radius);
+                    bool drawImageFromBuffer(uint32_t* buffer, int x, int y,
+                                             int width, int height);
+
+                    void print(const char* format, ...);
+                    void printAt(int32_t x, int32_t y, const char* format, ...);
+                    void newLine();
+                    void clearScreen();
+                    void clearScreen(const color& c);
+                    void clearLine(int32_t row);
+
+                    bool pressing();
+                    int32_t xPosition();
+                    int32_t yPosition();
+                    bool render();
+            };
+
+            class sdcard
+            {
+                public:
+                    bool isInserted();
+                    int32_t savefile(const char* name, uint8_t* buffer, int32_t len);
+                    int32_t appendfile(const char* name, uint8_t* buffer, int32_t len);
+                    int32_t loadfile(const char* name, uint8_t* buffer, int32_t len);
+                    int32_t size(const char* name);
+                    bool exists(const char* name);
+            };
+
+            lcd Screen;
+            sdcard SDcard;
+            timer Timer;
+    };
+
+    /*-------------------------------------------------------------------------
+     * CONTROLLER
+     *-----------------------------------------------------------------------*/
+
+    class controller
+    {
+        public:
+            class lcd
+            {
+                public:
+                    void setCursor(int32_t row, int32_t col);
+                    void print(const char* format, ...);
+                    void clearLine(int32_t row);
+                    void clearScreen();
+            };
+
+            controller (controllerType type = primary);
+            lcd Screen;
+    };
+}
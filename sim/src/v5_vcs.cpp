@@ -0,0 +1,936 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       v5_vcs.cpp (host simulator)                               */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Software implementation of the vex:: API subset           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "v5_vcs.h"
+#include "sim.h"
+
+using namespace vex;
+
+/* ---------- Simulator State ---------- */
+
+namespace
+{
+    const int ROW_HEIGHT = 20;      // mono20 text row height
+    const int COL_WIDTH  = 10;      // mono20 character width
+
+    struct Pen
+    {
+        uint32_t color = 0xFFFFFF;
+        bool transparent = false;
+    };
+
+    struct Screen
+    {
+        std::mutex lock;
+        uint32_t pixels[sim::WIDTH * sim::HEIGHT];
+        Pen pen;
+        Pen fill;
+        int originX = 0, originY = 0;
+        int cursorRow = 1, cursorCol = 1;
+        char lastText[128] = "";
+        sim::DrawStats stats = sim::DrawStats();
+
+        // touch: a queued tap is reported pressed once, then released
+        bool pressed = false;
+        bool releaseOnRead = false;
+        bool tapQueued = false;
+        int touchX = 0, touchY = 0;
+    };
+
+    struct Device
+    {
+        V5_DeviceType type = kDeviceTypeNoSensor;
+        double temperature = 25.0;
+        double voltage = 0.0;
+        double heading = 0.0;
+    };
+
+    // controller screen: 3 rows of 19 characters
+    struct ControllerScreen
+    {
+        std::mutex lock;
+        char rows[3][20];
+        int row = 1, col = 1;
+        uint32_t writes = 0;
+
+        ControllerScreen () { clear(); }
+        void clear() { for (auto& r : rows) { memset(r, ' ', 19); r[19] = 0; } }
+    };
+
+    Screen screen;
+    ControllerScreen pad;
+    std::mutex deviceLock;
+    Device devices[21];
+    std::atomic<double> timeScale(1.0);
+    char sdDirectory[256] = "sd";
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    uint64_t nowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    uint32_t parseHex(const char* hex)
+    {
+        if (!hex)
+        {
+            return 0;
+        }
+        if (*hex == '#')
+        {
+            hex++;
+        }
+        return (uint32_t)strtoul(hex, nullptr, 16) & 0xFFFFFF;
+    }
+
+    // caller holds screen.lock
+    void plot(int x, int y, uint32_t c)
+    {
+        if (x >= 0 && x < sim::WIDTH && y >= 0 && y < sim::HEIGHT)
+        {
+            screen.pixels[y * sim::WIDTH + x] = c;
+            screen.stats.pixels++;
+        }
+    }
+    void fillRect(int x, int y, int w, int h, uint32_t c)
+    {
+        for (int j = y; j < y + h; j++)
+        {
+            for (int i = x; i < x + w; i++)
+            {
+                plot(i, j, c);
+            }
+        }
+    }
+    void line(int x1, int y1, int x2, int y2, uint32_t c)
+    {
+        int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+        int dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+        int err = dx + dy;
+        while (true)
+        {
+            plot(x1, y1, c);
+            if (x1 == x2 && y1 == y2)
+            {
+                break;
+            }
+            int e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x1 += sx; }
+            if (e2 <= dx) { err += dx; y1 += sy; }
+        }
+    }
+
+    // text is recorded, only its background box is drawn
+    void text(int x, int top, const char* format, va_list args)
+    {
+        vsnprintf(screen.lastText, sizeof(screen.lastText), format, args);
+        int width = (int)strlen(screen.lastText) * COL_WIDTH;
+        if (!screen.fill.transparent)
+        {
+            fillRect(x, top, width, ROW_HEIGHT, screen.fill.color);
+        }
+    }
+
+    FILE* openSD(const char* name, const char* mode)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", sdDirectory, name);
+        return fopen(path, mode);
+    }
+}
+
+
+/* ---------- Colors ---------- */
+
+color::color (const char* hex) : value(parseHex(hex)), clear(false) {}
+
+color color::makeTransparent()
+{
+    color c;
+    c.clear = true;
+    return c;
+}
+
+namespace vex
+{
+    const color black(0x000000u);
+    const color white(0xFFFFFF);
+    const color red(0xFF0000);
+    const color green(0x00FF00);
+    const color blue(0x0000FF);
+    const color yellow(0xFFFF00);
+    const color orange(0xFFA500);
+    const color purple(0xFF00FF);
+    const color cyan(0x00FFFF);
+    const color transparent = color::makeTransparent();
+}
+
+
+/* ---------- Time ---------- */
+
+timer::timer () : start(nowMicros()) {}
+double timer::time(timeUnits units) const
+{
+    double ms = (nowMicros() - start) / 1000.0;
+    return units == sec ? ms / 1000.0 : ms;
+}
+void timer::clear()
+{
+    start = nowMicros();
+}
+uint32_t timer::system()
+{
+    return (uint32_t)(nowMicros() / 1000);
+}
+uint64_t timer::systemHighResolution()
+{
+    return nowMicros();
+}
+
+
+/* ---------- Tasks ---------- */
+
+struct task::state
+{
+    pthread_t thread;
+    int (*callback)(void*) = nullptr;
+    int (*simple)() = nullptr;
+    void* arg = nullptr;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> joined{false};
+    std::atomic<int> refs{2};           // task object + thread
+};
+
+namespace
+{
+    std::mutex taskLock;
+    std::vector<task::state*> running;
+    thread_local task::state* current = nullptr;
+
+    void releaseState(task::state* st)
+    {
+        if (st->refs.fetch_sub(1) == 1)
+        {
+            delete st;
+        }
+    }
+
+    // destroyed on thread exit, including exits through pthread_exit()
+    struct TaskExit
+    {
+        task::state* st = nullptr;
+        ~TaskExit()
+        {
+            if (!st)
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> guard(taskLock);
+                for (size_t i = 0; i < running.size(); i++)
+                {
+                    if (running[i] == st)
+                    {
+                        running.erase(running.begin() + i);
+                        break;
+                    }
+                }
+            }
+            releaseState(st);
+        }
+    };
+    thread_local TaskExit taskExit;
+
+    void* runTask(void* arg)
+    {
+        task::state* st = static_cast<task::state*>(arg);
+        current = st;
+        taskExit.st = st;
+        if (st->callback)
+        {
+            st->callback(st->arg);
+        }
+        else if (st->simple)
+        {
+            st->simple();
+        }
+        return nullptr;
+    }
+
+    task::state* startTask(task::state* st)
+    {
+        {
+            std::lock_guard<std::mutex> guard(taskLock);
+            running.push_back(st);
+        }
+        pthread_create(&st->thread, nullptr, runTask, st);
+        return st;
+    }
+
+    void stopTask(task::state* st)
+    {
+        if (st == current)
+        {
+            pthread_exit(nullptr);
+        }
+        st->stopRequested.store(true);
+        if (!st->joined.exchange(true))
+        {
+            pthread_join(st->thread, nullptr);
+        }
+    }
+}
+
+task::task (int (*callback)(void*), void* arg) : st(new state)
+{
+    st->callback = callback;
+    st->arg = arg;
+    startTask(st);
+}
+task::task (int (*callback)()) : st(new state)
+{
+    st->simple = callback;
+    startTask(st);
+}
+task::task (int (*callback)(), int32_t) : task(callback)
+{
+}
+task::~task ()
+{
+    // like the VEX SDK, destroying the object does not stop the task
+    if (!st->joined.exchange(true))
+    {
+        pthread_detach(st->thread);
+    }
+    releaseState(st);
+}
+void task::stop()
+{
+    stopTask(st);
+}
+void task::sleep(uint32_t ms)
+{
+    wait(ms, msec);
+}
+void task::yield()
+{
+    wait(0, msec);
+}
+
+void vex::wait(double time, timeUnits units)
+{
+    if (current && current->stopRequested.load())
+    {
+        pthread_exit(nullptr);
+    }
+    double ms = (units == sec ? time * 1000.0 : time) * timeScale.load();
+    if (ms > 0)
+    {
+        struct timespec ts;
+        ts.tv_sec = (time_t)(ms / 1000.0);
+        ts.tv_nsec = (long)((ms - ts.tv_sec * 1000.0) * 1e6);
+        nanosleep(&ts, nullptr);
+    }
+    else
+    {
+        sched_yield();
+    }
+    if (current && current->stopRequested.load())
+    {
+        pthread_exit(nullptr);
+    }
+}
+
+
+/* ---------- Devices ---------- */
+
+bool device::installed()
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    return port >= 0 && port < 21 && devices[port].type != kDeviceTypeNoSensor;
+}
+V5_DeviceType device::type()
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    return (port >= 0 && port < 21) ? devices[port].type : kDeviceTypeNoSensor;
+}
+
+motor::motor (int32_t index, gearSetting, bool) : device(index)
+{
+    sim::setDevice(index, kDeviceTypeMotorSensor);
+}
+double motor::temperature(temperatureUnits units)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    double c = devices[port].temperature;
+    return units == fahrenheit ? c * 9.0 / 5.0 + 32.0 : c;
+}
+double motor::voltage(voltageUnits units)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    double v = devices[port].voltage;
+    return units == mV ? v * 1000.0 : v;
+}
+double motor_group::voltage(voltageUnits units)
+{
+    double sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += motors[i]->voltage(units);
+    }
+    return count ? sum / count : 0;
+}
+
+inertial::inertial (int32_t index) : device(index)
+{
+    sim::setDevice(index, kDeviceTypeImuSensor);
+}
+double inertial::heading(rotationUnits)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    return devices[port].heading;
+}
+double inertial::rotation(rotationUnits)
+{
+    return heading(deg);
+}
+
+
+/* ---------- Brain Screen ---------- */
+
+void brain::lcd::setPenColor(const color& c)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.penChanges++;
+    screen.pen.color = c.rgb();
+    screen.pen.transparent = c.isTransparent();
+}
+void brain::lcd::setPenColor(const char* hex)
+{
+    setPenColor(color(hex));
+}
+void brain::lcd::setFillColor(const color& c)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.fillChanges++;
+    screen.fill.color = c.rgb();
+    screen.fill.transparent = c.isTransparent();
+}
+void brain::lcd::setFillColor(const char* hex)
+{
+    setFillColor(color(hex));
+}
+void brain::lcd::setPenWidth(uint32_t) {}
+void brain::lcd::setOrigin(int32_t x, int32_t y)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.originX = x;
+    screen.originY = y;
+}
+void brain::lcd::setCursor(int32_t row, int32_t col)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.cursorRow = row;
+    screen.cursorCol = col;
+}
+void brain::lcd::setFont(fontType) {}
+
+void brain::lcd::drawPixel(int x, int y)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    if (!screen.pen.transparent)
+    {
+        plot(x + screen.originX, y + screen.originY, screen.pen.color);
+    }
+}
+void brain::lcd::drawLine(int x1, int y1, int x2, int y2)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    if (!screen.pen.transparent)
+    {
+        line(x1 + screen.originX, y1 + screen.originY,
+             x2 + screen.originX, y2 + screen.originY, screen.pen.color);
+    }
+}
+void brain::lcd::drawRectangle(int x, int y, int width, int height)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    x += screen.originX;
+    y += screen.originY;
+    if (!screen.fill.transparent)
+    {
+        fillRect(x, y, width, height, screen.fill.color);
+    }
+    if (!screen.pen.transparent)
+    {
+        uint32_t c = screen.pen.color;
+        line(x, y, x + width - 1, y, c);
+        line(x, y + height - 1, x + width - 1, y + height - 1, c);
+        line(x, y, x, y + height - 1, c);
+        line(x + width - 1, y, x + width - 1, y + height - 1, c);
+    }
+}
+void brain::lcd::drawCircle(int x, int y, int radius)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    x += screen.originX;
+    y += screen.originY;
+    for (int j = -radius; j <= radius; j++)
+    {
+        for (int i = -radius; i <= radius; i++)
+        {
+            int d = i * i + j * j;
+            if (d > radius * radius)
+            {
+                continue;
+            }
+            bool edge = d > (radius - 1) * (radius - 1);
+            if (edge && !screen.pen.transparent)
+            {
+                plot(x + i, y + j, screen.pen.color);
+            }
+            else if (!edge && !screen.fill.transparent)
+            {
+                plot(x + i, y + j, screen.fill.color);
+            }
+        }
+    }
+}
+bool brain::lcd::drawImageFromBuffer(uint32_t* buffer, int x, int y, int width, int height)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    for (int j = 0; j < height; j++)
+    {
+        for (int i = 0; i < width; i++)
+        {
+            plot(x + i, y + j, buffer[j * width + i] & 0xFFFFFF);
+        }
+    }
+    return true;
+}
+
+void brain::lcd::print(const char* format, ...)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    int x = (screen.cursorCol - 1) * COL_WIDTH + screen.originX;
+    int top = (screen.cursorRow - 1) * ROW_HEIGHT + screen.originY;
+    va_list args;
+    va_start(args, format);
+    text(x, top, format, args);
+    va_end(args);
+    screen.cursorCol += (int)strlen(screen.lastText);
+}
+void brain::lcd::printAt(int32_t x, int32_t y, const char* format, ...)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    va_list args;
+    va_start(args, format);
+    // y is the text baseline
+    text(x + screen.originX, y + screen.originY - ROW_HEIGHT + 5, format, args);
+    va_end(args);
+}
+void brain::lcd::newLine()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.cursorRow++;
+    screen.cursorCol = 1;
+}
+void brain::lcd::clearScreen()
+{
+    clearScreen(black);
+}
+void brain::lcd::clearScreen(const color& c)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    fillRect(0, 0, sim::WIDTH, sim::HEIGHT, c.rgb());
+}
+void brain::lcd::clearLine(int32_t row)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats.drawCalls++;
+    fillRect(0, (row - 1) * ROW_HEIGHT, sim::WIDTH, ROW_HEIGHT, 0);
+}
+
+bool brain::lcd::pressing()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    if (screen.releaseOnRead)
+    {
+        screen.releaseOnRead = false;
+        screen.pressed = false;
+        return false;
+    }
+    if (screen.tapQueued)
+    {
+        screen.tapQueued = false;
+        screen.pressed = true;
+        screen.releaseOnRead = true;
+    }
+    return screen.pressed;
+}
+int32_t brain::lcd::xPosition()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    return screen.touchX;
+}
+int32_t brain::lcd::yPosition()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    return screen.touchY;
+}
+bool brain::lcd::render()
+{
+    return true;
+}
+
+
+/* ---------- Brain SD Card ---------- */
+
+bool brain::sdcard::isInserted()
+{
+    return true;
+}
+int32_t brain::sdcard::savefile(const char* name, uint8_t* buffer, int32_t len)
+{
+    FILE* file = openSD(name, "wb");
+    if (!file)
+    {
+        return 0;
+    }
+    int32_t written = (int32_t)fwrite(buffer, 1, len, file);
+    fclose(file);
+    return written;
+}
+int32_t brain::sdcard::appendfile(const char* name, uint8_t* buffer, int32_t len)
+{
+    FILE* file = openSD(name, "ab");
+    if (!file)
+    {
+        return 0;
+    }
+    int32_t written = (int32_t)fwrite(buffer, 1, len, file);
+    fclose(file);
+    return written;
+}
+int32_t brain::sdcard::loadfile(const char* name, uint8_t* buffer, int32_t len)
+{
+    FILE* file = openSD(name, "rb");
+    if (!file)
+    {
+        return 0;
+    }
+    int32_t read = (int32_t)fread(buffer, 1, len, file);
+    fclose(file);
+    return read;
+}
+int32_t brain::sdcard::size(const char* name)
+{
+    FILE* file = openSD(name, "rb");
+    if (!file)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    int32_t bytes = (int32_t)ftell(file);
+    fclose(file);
+    return bytes;
+}
+bool brain::sdcard::exists(const char* name)
+{
+    FILE* file = openSD(name, "rb");
+    if (file)
+    {
+        fclose(file);
+    }
+    return file != nullptr;
+}
+
+
+/* ---------- SDK File Access ---------- */
+
+FIL_T* vexFileOpen(const char* filename, const char* mode)
+{
+    (void)mode;                 // the SDK opens for reading
+    return openSD(filename, "rb");
+}
+FIL_T* vexFileOpenWrite(const char* filename)
+{
+    return openSD(filename, "wb");
+}
+void vexFileClose(FIL_T* fdp)
+{
+    if (fdp)
+    {
+        fclose(static_cast<FILE*>(fdp));
+    }
+}
+int32_t vexFileRead(char* buf, uint32_t size, uint32_t nItems, FIL_T* fdp)
+{
+    return fdp ? (int32_t)fread(buf, size, nItems, static_cast<FILE*>(fdp)) : 0;
+}
+int32_t vexFileWrite(char* buf, uint32_t size, uint32_t nItems, FIL_T* fdp)
+{
+    return fdp ? (int32_t)fwrite(buf, size, nItems, static_cast<FILE*>(fdp)) : 0;
+}
+int32_t vexFileSize(FIL_T* fdp)
+{
+    FILE* file = static_cast<FILE*>(fdp);
+    if (!file)
+    {
+        return 0;
+    }
+    long at = ftell(file);
+    fseek(file, 0, SEEK_END);
+    long bytes = ftell(file);
+    fseek(file, at, SEEK_SET);
+    return (int32_t)bytes;
+}
+
+
+/* ---------- Controller ---------- */
+
+controller::controller (controllerType) {}
+void controller::lcd::setCursor(int32_t row, int32_t col)
+{
+    std::lock_guard<std::mutex> guard(pad.lock);
+    pad.row = row;
+    pad.col = col;
+}
+void controller::lcd::print(const char* format, ...)
+{
+    char text[64];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    std::lock_guard<std::mutex> guard(pad.lock);
+    pad.writes++;
+    for (const char* c = text; *c && pad.col <= 19; c++, pad.col++)
+    {
+        if (pad.row >= 1 && pad.row <= 3 && pad.col >= 1)
+        {
+            pad.rows[pad.row - 1][pad.col - 1] = *c;
+        }
+    }
+}
+void controller::lcd::clearLine(int32_t row)
+{
+    std::lock_guard<std::mutex> guard(pad.lock);
+    pad.writes++;
+    if (row >= 1 && row <= 3)
+    {
+        memset(pad.rows[row - 1], ' ', 19);
+    }
+}
+void controller::lcd::clearScreen()
+{
+    std::lock_guard<std::mutex> guard(pad.lock);
+    pad.writes++;
+    pad.clear();
+}
+
+
+/* ---------- Simulator Control ---------- */
+
+const uint32_t* sim::framebuffer()
+{
+    return screen.pixels;
+}
+uint32_t sim::pixel(int x, int y)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+    {
+        return 0;
+    }
+    return screen.pixels[y * WIDTH + x];
+}
+bool sim::savePPM(const char* path)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    return savePPM(path, screen.pixels, WIDTH, HEIGHT);
+}
+bool sim::savePPM(const char* path, const uint32_t* pixels, int width, int height)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file)
+    {
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    for (int i = 0; i < width * height; i++)
+    {
+        uint8_t rgb[3] = { (uint8_t)(pixels[i] >> 16), (uint8_t)(pixels[i] >> 8), (uint8_t)pixels[i] };
+        fwrite(rgb, 1, 3, file);
+    }
+    return fclose(file) == 0;
+}
+void sim::reset()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    memset(screen.pixels, 0, sizeof(screen.pixels));
+    screen.pen = Pen();
+    screen.fill = Pen();
+    screen.fill.color = 0;
+    screen.originX = screen.originY = 0;
+    screen.cursorRow = screen.cursorCol = 1;
+    screen.lastText[0] = 0;
+    screen.pressed = screen.releaseOnRead = screen.tapQueued = false;
+    screen.stats = DrawStats();
+}
+
+sim::DrawStats sim::drawStats()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    return screen.stats;
+}
+void sim::resetDrawStats()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.stats = DrawStats();
+}
+
+void sim::tap(int x, int y)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.touchX = x;
+    screen.touchY = y;
+    screen.tapQueued = true;
+}
+void sim::press(int x, int y)
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.touchX = x;
+    screen.touchY = y;
+    screen.pressed = true;
+    screen.releaseOnRead = false;
+}
+void sim::release()
+{
+    std::lock_guard<std::mutex> guard(screen.lock);
+    screen.pressed = false;
+}
+
+void sim::setTimeScale(double scale)
+{
+    timeScale.store(scale < 0 ? 0 : scale);
+}
+void sim::stopAllTasks()
+{
+    while (true)
+    {
+        task::state* st = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(taskLock);
+            for (size_t i = 0; i < running.size(); i++)
+            {
+                if (!running[i]->stopRequested.load())
+                {
+                    st = running[i];
+                    st->refs.fetch_add(1);
+                    break;
+                }
+            }
+        }
+        if (!st)
+        {
+            break;
+        }
+        st->stopRequested.store(true);
+        if (!st->joined.exchange(true))
+        {
+            pthread_join(st->thread, nullptr);
+        }
+        releaseState(st);
+    }
+    // detached tasks that were already asked to stop exit at their next wait
+    while (liveTasks() > 0)
+    {
+        sched_yield();
+    }
+}
+int sim::liveTasks()
+{
+    std::lock_guard<std::mutex> guard(taskLock);
+    return (int)running.size();
+}
+
+void sim::setDevice(int port, V5_DeviceType type)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    if (port >= 0 && port < 21)
+    {
+        devices[port].type = type;
+    }
+}
+void sim::setMotor(int port, double temperature, double voltage)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    if (port >= 0 && port < 21)
+    {
+        devices[port].temperature = temperature;
+        devices[port].voltage = voltage;
+    }
+}
+void sim::setHeading(int port, double heading)
+{
+    std::lock_guard<std::mutex> guard(deviceLock);
+    if (port >= 0 && port < 21)
+    {
+        devices[port].heading = heading;
+    }
+}
+
+void sim::setSDRoot(const char* path)
+{
+    snprintf(sdDirectory, sizeof(sdDirectory), "%s", path);
+}
+const char* sim::sdRoot()
+{
+    return sdDirectory;
+}
+
+const char* sim::lastText()
+{
+    return screen.lastText;
+}
+
+const char* sim::controllerLine(int row)
+{
+    std::lock_guard<std::mutex> guard(pad.lock);
+    return row >= 0 && row < 3 ? pad.rows[row] : "";
+}
+uint32_t sim::controllerWrites()
+{
+    std::lock_guard<std::mutex> guard(pad.lock);
+    return pad.writes;
+}
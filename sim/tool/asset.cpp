@@ -0,0 +1,149 @@
+#include "tool.h"
+
+/*  Asset files are read and written through the simulated SD card, so
+    these commands point sim::setSDRoot() at the directory of the file
+    and use its base name, exactly as the robot would. */
+
+const char* useDirectoryOf(const char* path)
+{
+    static char directory[512];
+    const char* slash = strrchr(path, '/');
+    if (!slash)
+    {
+        sim::setSDRoot(".");
+        return path;
+    }
+    snprintf(directory, sizeof(directory), "%.*s", (int)(slash - path), path);
+    sim::setSDRoot(directory[0] ? directory : "/");
+    return slash + 1;
+}
+
+static int readNumber(FILE* file)
+{
+    int c = fgetc(file);
+    while (c == '#' || c == ' ' || c == '\n' || c == '\r' || c == '\t')
+    {
+        if (c == '#')
+        {
+            while (c != '\n' && c != EOF)
+            {
+                c = fgetc(file);
+            }
+        }
+        c = fgetc(file);
+    }
+    int value = -1;
+    while (c >= '0' && c <= '9')
+    {
+        value = (value < 0 ? 0 : value * 10) + (c - '0');
+        c = fgetc(file);
+    }
+    return value;       // the single whitespace after it is consumed
+}
+
+// binary PPM (P6, maxval 255) into a new 0x00RRGGBB buffer
+static uint32_t* loadPPM(const char* path, int& width, int& height)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return nullptr;
+    }
+    uint32_t* pixels = nullptr;
+    if (fgetc(file) == 'P' && fgetc(file) == '6')
+    {
+        width = readNumber(file);
+        height = readNumber(file);
+        int maxval = readNumber(file);
+        if (width > 0 && height > 0 && maxval == 255)
+        {
+            pixels = new uint32_t[width * height];
+            for (int i = 0; i < width * height; i++)
+            {
+                uint8_t rgb[3] = { 0, 0, 0 };
+                if (fread(rgb, 1, 3, file) != 3)
+                {
+                    break;
+                }
+                pixels[i] = ((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2];
+            }
+        }
+    }
+    fclose(file);
+    if (!pixels)
+    {
+        fprintf(stderr, "%s is not a binary PPM with maxval 255\n", path);
+    }
+    return pixels;
+}
+
+
+/* ---------- pack ---------- */
+
+int packCommand(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: pack <screen|in.ppm> <out.wlia> [#rrggbb transparent]\n");
+        return 2;
+    }
+    int width = SCREEN_WIDTH, height = SCREEN_HEIGHT;
+    uint32_t* pixels = nullptr;
+    for (int i = 0; i < screenCount && !pixels; i++)
+    {
+        if (strcmp(argv[0], screens[i].name) == 0)
+        {
+            sim::reset();
+            Brain.Screen.clearScreen();
+            screens[i].display();
+            pixels = new uint32_t[width * height];
+            memcpy(pixels, sim::framebuffer(), width * height * sizeof(uint32_t));
+        }
+    }
+    if (!pixels && !(pixels = loadPPM(argv[0], width, height)))
+    {
+        return 1;
+    }
+    uint32_t key = argc > 2 ? parseColor(argv[2]) : ASSET_NO_KEY;
+
+    const char* name = useDirectoryOf(argv[1]);
+    bool ok = saveAsset(name, pixels, width, height, key);
+    delete[] pixels;
+    if (!ok)
+    {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    int bytes = Brain.SDcard.size(name);
+    printf("%s: %dx%d, %d bytes (%.1f%% of raw)\n", argv[1], width, height, bytes,
+           100.0 * bytes / (width * height * 4));
+    return 0;
+}
+
+
+/* ---------- unpack ---------- */
+
+int unpackCommand(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: unpack <in.wlia> <out.ppm>\n");
+        return 2;
+    }
+    const char* name = useDirectoryOf(argv[0]);
+    sim::reset();
+    Brain.Screen.clearScreen();
+    uint64_t start = nowNanos();
+    bool ok = drawAsset(name);
+    uint64_t elapsed = nowNanos() - start;
+    if (!ok)
+    {
+        fprintf(stderr, "%s: missing or malformed asset\n", argv[0]);
+        return 1;
+    }
+    sim::DrawStats stats = sim::drawStats();
+    printf("%s: drawn in %.3f ms, %llu draw calls, %llu pen changes\n", argv[0],
+           elapsed / 1e6, (unsigned long long)stats.drawCalls, (unsigned long long)stats.penChanges);
+    return sim::savePPM(argv[1]) ? 0 : 1;
+}
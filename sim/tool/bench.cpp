@@ -0,0 +1,74 @@
+#include "tool.h"
+
+/* ---------- bench ---------- */
+
+enum BenchMode { BENCH_DISPLAY, BENCH_UPDATE, BENCH_BUFFERED };
+
+// times n calls of display() or update(), or of display() recorded into
+// the shared RenderBuffer; counters are for a single call
+static void benchOne(FILE* out, const BuiltinScreen& screen, BenchMode mode, int n)
+{
+    static const char* const modeNames[] = { "display", "update", "buffered" };
+    bool update = mode == BENCH_UPDATE;
+    RenderBuffer* buffer = mode == BENCH_BUFFERED ? Interface::getRenderBuffer() : nullptr;
+    sim::reset();
+    if (update)
+    {
+        screen.display();       // updates draw over their own screen
+    }
+
+    uint64_t total = 0, best = UINT64_MAX;
+    sim::DrawStats stats = sim::DrawStats();
+    for (int i = 0; i < n; i++)
+    {
+        sim::resetDrawStats();
+        uint64_t start = nowNanos();
+        if (update)
+        {
+            screen.update();
+        }
+        else if (buffer)
+        {
+            buffer->begin();
+            screen.display();
+            buffer->end();
+        }
+        else
+        {
+            screen.display();
+        }
+        uint64_t elapsed = nowNanos() - start;
+        total += elapsed;
+        best = elapsed < best ? elapsed : best;
+        stats = sim::drawStats();
+    }
+
+    fprintf(out, "%s,%s,%d,%.3f,%.3f,%llu,%llu,%llu,%llu\n",
+            screen.name, modeNames[mode], n,
+            total / 1000.0 / n, best / 1000.0,
+            (unsigned long long)stats.drawCalls, (unsigned long long)stats.penChanges,
+            (unsigned long long)stats.fillChanges, (unsigned long long)stats.pixels);
+}
+
+int benchCommand(int argc, char** argv)
+{
+    FILE* out = openOutput(argc > 0 ? argv[0] : nullptr);
+    if (!out)
+    {
+        return 1;
+    }
+    int n = argc > 1 ? atoi(argv[1]) : 100;
+    n = n > 0 ? n : 1;
+
+    fprintf(out, "screen,function,iterations,mean_us,min_us,draw_calls,pen_changes,fill_changes,pixels\n");
+    for (int i = 0; i < screenCount; i++)
+    {
+        benchOne(out, screens[i], BENCH_DISPLAY, n);
+        benchOne(out, screens[i], BENCH_BUFFERED, n);
+        if (screens[i].update)
+        {
+            benchOne(out, screens[i], BENCH_UPDATE, n);
+        }
+    }
+    return closeOutput(out);
+}
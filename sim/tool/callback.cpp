@@ -0,0 +1,105 @@
+#include "tool.h"
+
+/*  Runs every way the library uses a Callback (construct from a function
+    pointer, a null pointer and lambdas, copy, assign, clear and invoke)
+    under the HeapTracker and checks that none of it allocated. The type
+    checks below are compile time: a callable with the wrong arguments or
+    return type must not be accepted by overload resolution. */
+
+static_assert(std::is_constructible<ActionCallback, void (*)(int)>::value, "function pointer");
+static_assert(!std::is_constructible<ActionCallback, void (*)(const char*)>::value,
+              "wrong argument type accepted");
+static_assert(!std::is_constructible<UpdateCallback, void (*)()>::value,
+              "void callable accepted for an int result");
+static_assert(!std::is_constructible<UpdateCallback, const char* (*)()>::value,
+              "pointer result accepted for an int result");
+static_assert(std::is_constructible<UpdateCallback, short (*)()>::value, "convertible result");
+static_assert(!std::is_constructible<DisplayCallback, int (*)()>::value,
+              "int callable accepted for a void result");
+
+static int calls = 0;
+static void countDisplay()
+{
+    calls++;
+}
+static int countUpdate()
+{
+    return ++calls;
+}
+
+struct Counter
+{
+    int* total;
+    int step;
+    void operator()(int button) const
+    {
+        *total += button * step;
+    }
+};
+
+int callbackCommand(int argc, char** argv)
+{
+    int rounds = argc > 0 ? atoi(argv[0]) : 1000;
+    rounds = rounds > 0 ? rounds : 1000;
+    if (!HeapTracker::isEnabled())
+    {
+        fprintf(stderr, "callback: built without WLIC_TRACK_MEMORY\n");
+        return 1;
+    }
+
+    int total = 0;
+    int expected = 0;
+    HeapStats before = HeapTracker::getStats();
+    for (int r = 0; r < rounds; r++)
+    {
+        // construct
+        DisplayCallback display = countDisplay;
+        DisplayCallback empty = nullptr;
+        void (*none)() = nullptr;
+        DisplayCallback fromNull = none;
+        UpdateCallback update = countUpdate;
+        ActionCallback lambda = [&total](int button) { total += button; };
+        ActionCallback functor = Counter { &total, 3 };
+        int a = 1, b = 2, c = 3;
+        UpdateCallback captures = [&total, a, b, c]() { return total + a + b + c; };
+
+        // copy and assign
+        ActionCallback copy(lambda);
+        ActionCallback assigned;
+        assigned = functor;
+        assigned = assigned;
+        DisplayCallback reassigned = display;
+        reassigned = empty;
+        ActionCallback cleared(functor);
+        cleared.clear();
+
+        // invoke
+        display();
+        update();
+        lambda(1);
+        copy(2);
+        functor(1);
+        assigned(1);
+        captures();
+        expected += 1 + 2 + 3 + 3;
+        if (empty || fromNull || reassigned || cleared || !copy || !assigned)
+        {
+            fprintf(stderr, "callback: round %d, an empty callback reports a callable or "
+                    "a copy lost its callable\n", r);
+            return 1;
+        }
+    }
+    HeapStats after = HeapTracker::getStats();
+
+    uint32_t allocations = after.allocations - before.allocations;
+    bool ok = allocations == 0 && total == expected && calls == 2 * rounds;
+    printf("%d rounds of construct, copy, assign and invoke: %lu allocations, %lu bytes\n", rounds,
+           (unsigned long)allocations, (unsigned long)(after.bytes - before.bytes));
+    if (total != expected || calls != 2 * rounds)
+    {
+        printf("wrong results: total %d (expected %d), calls %d (expected %d)\n", total, expected,
+               calls, 2 * rounds);
+    }
+    printf("callback %s\n", ok ? "allocation-free" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include "tool.h"
+
+/*  A two-minute match on a figure eight, fed to FieldMap every 10 ms while
+    the map is drawn every 50 ms, as the Field screen's update task does.
+    Reports how much the trail kept and how much each update drew, against
+    drawing the whole map once. The pose text is left out of both. */
+
+#define FIELDMAP_SAMPLE_MS 10
+#define FIELDMAP_UPDATE_MS 50
+
+static void figureEight(double t, Pose& pose)
+{
+    const double w = 2 * pi / 20;       // one lap every 20 s
+    pose.x = 120 * sin(w * t);
+    pose.y = 80 * sin(2 * w * t);
+    double dx = 120 * w * cos(w * t);
+    double dy = 160 * w * cos(2 * w * t);
+    pose.heading = atan2(dx, dy) * 180 / pi;
+    if (pose.heading < 0)
+    {
+        pose.heading += 360;
+    }
+}
+
+int fieldmapCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: fieldmap <out.ppm> [seconds]\n");
+        return 2;
+    }
+    int seconds = argc > 1 ? atoi(argv[1]) : 120;
+
+    sim::reset();
+    FieldMap::clear();
+    displayField();
+    FieldMap::draw();
+
+    uint64_t updates = 0, pixels = 0, maxPixels = 0;
+    for (int ms = 0; ms <= seconds * 1000; ms += FIELDMAP_SAMPLE_MS)
+    {
+        Pose pose;
+        figureEight(ms / 1000.0, pose);
+        FieldMap::add(pose.x, pose.y, pose.heading);
+        if (ms % FIELDMAP_UPDATE_MS == 0)
+        {
+            sim::resetDrawStats();
+            FieldMap::draw();
+            uint64_t drawn = sim::drawStats().pixels;
+            pixels += drawn;
+            maxPixels = drawn > maxPixels ? drawn : maxPixels;
+            updates++;
+        }
+    }
+    if (!sim::savePPM(argv[0]))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[0]);
+        return 1;
+    }
+
+    // the same trail drawn in one go, as when the screen is opened
+    uint32_t* incremental = new uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+    memcpy(incremental, sim::framebuffer(), FRAME_BYTES);
+    sim::reset();
+    displayField();
+    sim::resetDrawStats();
+    FieldMap::draw();
+    uint64_t fullPixels = sim::drawStats().pixels;
+    bool same = memcmp(incremental, sim::framebuffer(), FRAME_BYTES) == 0;
+    delete[] incremental;
+
+    FieldMapStats stats = FieldMap::getStats();
+    printf("%d s: %u poses, %u trail points (%u bytes), thinned %u times\n", seconds,
+           stats.samples, stats.points, (unsigned)sizeof(uint32_t) * FIELDMAP_TRAIL_POINTS, stats.thinned);
+    printf("per update: %.0f pixels mean, %llu max; full redraw %llu pixels\n",
+           updates ? (double)pixels / updates : 0.0, (unsigned long long)maxPixels,
+           (unsigned long long)fullPixels);
+    if (stats.thinned == 0)
+    {
+        printf("incremental screen %s the full redraw\n", same ? "matches" : "DIFFERS from");
+        return same ? 0 : 1;
+    }
+    return 0;
+}
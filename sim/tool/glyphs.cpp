@@ -0,0 +1,75 @@
+#include "tool.h"
+
+/*  A heading readout sweeping 0.0 to 359.9 in 0.1 degree steps, drawn the
+    three ways a screen can: printAt() every tick, a GlyphText redrawn
+    whole every tick, and a GlyphText that redraws only changed cells.
+    The simulator does not rasterize text, so printAt() only costs its
+    background box here; on the Brain it also renders every character. */
+
+#define GLYPHS_X 40
+#define GLYPHS_Y 60
+
+enum GlyphsMode { GLYPHS_PRINT, GLYPHS_FULL, GLYPHS_CHANGED };
+
+static void benchReadout(GlyphsMode mode, int n)
+{
+    static const char* const modeNames[] = { "printAt", "glyph full", "glyph changed" };
+    sim::reset();
+    GlyphText readout(glyphDigits, GLYPHS_X, GLYPHS_Y, 6, 2, GLYPH_RIGHT);
+    readout.setColors(0xFFFFFF, 0x5E5E5E);
+    Brain.Screen.setFont(mono40);
+    Brain.Screen.setPenColor(white);
+    Brain.Screen.setFillColor("#5E5E5E");
+
+    uint64_t start = nowNanos();
+    uint64_t cells = 0;
+    sim::resetDrawStats();
+    for (int i = 0; i < n; i++)
+    {
+        double heading = (i % 3600) / 10.0;
+        if (mode == GLYPHS_PRINT)
+        {
+            Brain.Screen.printAt(GLYPHS_X, GLYPHS_Y + 24, "%6.1f", heading);
+            continue;
+        }
+        if (mode == GLYPHS_FULL)
+        {
+            readout.invalidate();
+        }
+        cells += readout.print("%.1f", heading);
+    }
+    uint64_t elapsed = nowNanos() - start;
+    sim::DrawStats stats = sim::drawStats();
+
+    printf("%-14s %8.3f us %7.1f calls %8.1f pixels", modeNames[mode], elapsed / 1000.0 / n,
+           (double)stats.drawCalls / n, (double)stats.pixels / n);
+    if (mode != GLYPHS_PRINT)
+    {
+        printf(" %5.2f cells", (double)cells / n);
+    }
+    printf("   per update\n");
+}
+
+int glyphsCommand(int argc, char** argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 3600;
+    n = n > 0 ? n : 3600;
+    printf("atlas blocks: %d small, %d digits\n", glyphSmall.size(), glyphDigits.size());
+    benchReadout(GLYPHS_PRINT, n);
+    benchReadout(GLYPHS_FULL, n);
+    benchReadout(GLYPHS_CHANGED, n);
+
+    // a sample of both fonts
+    sim::reset();
+    glyphSmall.drawText(" !\"#$%&'()*+,-./0123456789:;<=>?", 8, 8, 2, 0xFFFFFF, 0x000000);
+    glyphSmall.drawText("@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_", 8, 28, 2, 0xFFFFFF, 0x000000);
+    glyphSmall.drawText("`abcdefghijklmnopqrstuvwxyz{|}~", 8, 48, 2, 0xFFFFFF, 0x000000);
+    glyphDigits.drawText("0123456789 +-./:%", 8, 80, 2, 0xFFFFFF, 0x000000);
+    glyphDigits.drawText("359.9", 8, 120, 6, 0xFFFFFF, 0x000000);
+    if (argc > 0 && !sim::savePPM(argv[0]))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
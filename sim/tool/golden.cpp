@@ -0,0 +1,333 @@
+#include "tool.h"
+
+/*  Golden file format, one case per line ('#' starts a comment):
+
+        <name> <frame hash> <row 0 hash> ... <row HEIGHT-1 hash>
+
+    The frame hash is FNV-1a 64 over the whole sim framebuffer, row hashes
+    are FNV-1a 32 per row. Only hashes are checked in, so on a mismatch the
+    diff image marks the rows that changed rather than individual pixels. */
+
+#define GOLDEN_DEFAULT_PATH "sim/golden/screens.golden"
+
+/* ---------- Decoder Cases ---------- */
+
+// the built-in images have no skip runs and rarely end a run on a row
+// edge, so these exercise the drawImageRLE() wrap and skip paths directly
+static const char* const rlePalette[] = { "#ff0000", "#00ff00", "#0000ff", "#ffffff" };
+
+static void drawRLEWrap()
+{
+    static const int indices[] = { 0, 1, 2, 3, 0, 1, 2, 3 };
+    static const int counts[]  = { 479, 1, 480, 481, 959, 1, 960, 1440 };
+    drawImageRLE(rlePalette, indices, counts, sizeof(indices) / sizeof(indices[0]));
+}
+
+static void drawRLESkip()
+{
+    static const int indices[] = { 0, -1, 1, -1, 2, -1, 3, -1, 0 };
+    static const int counts[]  = { 470, 10, 500, 1440, 30, 450, 481, 479, 960 };
+    drawImageRLE(rlePalette, indices, counts, sizeof(indices) / sizeof(indices[0]));
+}
+
+// hand-written drawing through a RenderBuffer: overlapping shapes in a
+// few colors, a fully covered rectangle, text and an origin change, so the
+// buffered variant has something to drop, reorder and keep in order
+static void drawBufferMix()
+{
+    RenderBuffer* rb = Interface::getRenderBuffer();
+    rb->setPenColor(0x202020u);
+    rb->setFillColor(0x202020u);
+    rb->drawRectangle(0, 0, 480, 240);
+    for (int i = 0; i < 12; i++)
+    {
+        rb->setPenColor(i % 2 ? 0xff0000u : 0x00ff00u);
+        rb->setFillColor(i % 3 ? 0x0000ffu : 0xffff00u);
+        rb->drawRectangle(10 + i * 38, 10 + (i % 4) * 12, 30, 30);
+        rb->setPenColor(i % 2 ? 0x00ff00u : 0xff0000u);
+        rb->drawSpan(10 + i * 38, 80, 30);
+        rb->drawSpan(10 + i * 38 + 30, 80, 8);
+    }
+    rb->setPenColor(0xffffffu);
+    rb->setFillColor(0x000000u);
+    rb->drawRectangle(100, 100, 20, 20);        // covered below
+    rb->setPenWidth(3);
+    rb->drawLine(20, 120, 460, 180);
+    rb->setPenWidth(1);
+    rb->setFillColor(0x5e5e5eu);
+    rb->drawRectangle(90, 95, 60, 40);
+    rb->drawCircle(300, 130, 25);
+    rb->setFont(mono20);
+    rb->printAt(20, 220, "buffer %d", 7);
+    rb->setOrigin(200, 150);
+    rb->setPenColor(0xff00ffu);
+    rb->setTransparentFill();
+    rb->drawRectangle(0, 0, 50, 50);
+    rb->drawPixel(25, 25);
+    rb->setOrigin(0, 0);
+}
+
+struct GoldenCase
+{
+    const char* name;
+    void (*draw)();
+    bool capture;       // drawn only with drawImageRLE(), so the .cached check applies
+};
+
+static int goldenCases(GoldenCase* out)
+{
+    int n = 0;
+    for (int i = 0; i < screenCount; i++)
+    {
+        out[n].name = screens[i].name;
+        out[n].draw = screens[i].display;
+        out[n].capture = true;
+        n++;
+    }
+    GoldenCase extra[] =
+    {
+        { "rle_wrap", drawRLEWrap, true },
+        { "rle_skip", drawRLESkip, true },
+        { "buffer_mix", drawBufferMix, false }
+    };
+    for (const GoldenCase& c : extra)
+    {
+        out[n++] = c;
+    }
+    return n;
+}
+
+
+/* ---------- Hashing ---------- */
+
+struct FrameHash
+{
+    uint64_t frame;
+    uint32_t rows[sim::HEIGHT];
+};
+
+static void hashFramebuffer(FrameHash& hash)
+{
+    const uint32_t* pixels = sim::framebuffer();
+    hash.frame = 14695981039346656037ULL;
+    for (int y = 0; y < sim::HEIGHT; y++)
+    {
+        uint32_t row = 2166136261u;
+        for (int x = 0; x < sim::WIDTH; x++)
+        {
+            uint32_t p = pixels[y * sim::WIDTH + x];
+            for (int b = 0; b < 4; b++)
+            {
+                uint8_t byte = (uint8_t)(p >> (8 * b));
+                row = (row ^ byte) * 16777619u;
+                hash.frame = (hash.frame ^ byte) * 1099511628211ULL;
+            }
+        }
+        hash.rows[y] = row;
+    }
+}
+
+// draw straight to the screen, as on a first visit
+static void renderDirect(const GoldenCase& c, FrameHash& hash)
+{
+    sim::reset();
+    Brain.Screen.clearScreen();
+    c.draw();
+    hashFramebuffer(hash);
+}
+
+// draw into a capture frame and blit it, as when Back restores a snapshot
+static void renderCached(const GoldenCase& c, FrameHash& hash)
+{
+    static uint32_t frame[SCREEN_WIDTH * SCREEN_HEIGHT];
+    sim::reset();
+    beginCapture(frame);
+    c.draw();
+    endCapture();
+    sim::reset();
+    Brain.Screen.clearScreen();
+    drawFrame(frame);
+    hashFramebuffer(hash);
+}
+
+// record into the shared RenderBuffer and replay it optimized, as buffered
+// interfaces do
+static void renderBuffered(const GoldenCase& c, FrameHash& hash)
+{
+    RenderBuffer* rb = Interface::getRenderBuffer();
+    sim::reset();
+    Brain.Screen.clearScreen();
+    rb->begin();
+    c.draw();
+    rb->end();
+    hashFramebuffer(hash);
+}
+
+
+/* ---------- Golden File ---------- */
+
+struct GoldenEntry
+{
+    char name[32];
+    FrameHash hash;
+};
+
+static int loadGolden(const char* path, GoldenEntry* entries, int max)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "cannot read %s (run `wlic-host golden` to create it)\n", path);
+        return -1;
+    }
+    static char line[sim::HEIGHT * 12 + 128];
+    int n = 0;
+    while (n < max && fgets(line, sizeof(line), file))
+    {
+        char* token = strtok(line, " \t\r\n");
+        if (!token || token[0] == '#')
+        {
+            continue;
+        }
+        GoldenEntry& entry = entries[n];
+        snprintf(entry.name, sizeof(entry.name), "%s", token);
+        token = strtok(nullptr, " \t\r\n");
+        entry.hash.frame = token ? strtoull(token, nullptr, 16) : 0;
+        for (int y = 0; y < sim::HEIGHT; y++)
+        {
+            token = strtok(nullptr, " \t\r\n");
+            entry.hash.rows[y] = token ? (uint32_t)strtoul(token, nullptr, 16) : 0;
+        }
+        n++;
+    }
+    fclose(file);
+    return n;
+}
+
+int goldenCommand(int argc, char** argv)
+{
+    const char* path = argc > 0 ? argv[0] : GOLDEN_DEFAULT_PATH;
+    FILE* file = openOutput(path);
+    if (!file)
+    {
+        return 1;
+    }
+    GoldenCase cases[32];
+    int count = goldenCases(cases);
+    fprintf(file, "# wlic-host golden screens: <name> <fnv1a-64 frame> <fnv1a-32 per row x %d>\n", sim::HEIGHT);
+    fprintf(file, "# regenerate with `build/host/wlic-host golden` only after checking the images\n");
+    for (int i = 0; i < count; i++)
+    {
+        FrameHash hash;
+        renderDirect(cases[i], hash);
+        fprintf(file, "%s %016llx", cases[i].name, (unsigned long long)hash.frame);
+        for (int y = 0; y < sim::HEIGHT; y++)
+        {
+            fprintf(file, " %08x", hash.rows[y]);
+        }
+        fprintf(file, "\n");
+    }
+    return closeOutput(file);
+}
+
+
+/* ---------- check ---------- */
+
+// saves the current screen, plus a copy with the changed rows tinted red
+static void writeDiff(const char* dir, const char* name, const FrameHash& expected,
+                      const FrameHash& actual)
+{
+    static uint32_t diff[sim::WIDTH * sim::HEIGHT];
+    const uint32_t* pixels = sim::framebuffer();
+    for (int y = 0; y < sim::HEIGHT; y++)
+    {
+        bool changed = expected.rows[y] != actual.rows[y];
+        for (int x = 0; x < sim::WIDTH; x++)
+        {
+            uint32_t p = pixels[y * sim::WIDTH + x];
+            diff[y * sim::WIDTH + x] = changed ? (0xFF0000 | ((p >> 1) & 0x007F7F))
+                                               : ((p >> 2) & 0x3F3F3F);
+        }
+    }
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.actual.ppm", dir, name);
+    sim::savePPM(path);
+    snprintf(path, sizeof(path), "%s/%s.diff.ppm", dir, name);
+    sim::savePPM(path, diff, sim::WIDTH, sim::HEIGHT);
+    printf("     wrote %s\n", path);
+}
+
+static bool compare(const char* label, const GoldenEntry& golden, const FrameHash& actual,
+                    const char* diffDir)
+{
+    if (golden.hash.frame == actual.frame)
+    {
+        printf("ok   %s\n", label);
+        return true;
+    }
+    int first = -1, changed = 0;
+    for (int y = 0; y < sim::HEIGHT; y++)
+    {
+        if (golden.hash.rows[y] != actual.rows[y])
+        {
+            first = first < 0 ? y : first;
+            changed++;
+        }
+    }
+    printf("FAIL %s: %d rows differ, first at y=%d\n", label, changed, first);
+    writeDiff(diffDir, label, golden.hash, actual);
+    return false;
+}
+
+int checkCommand(int argc, char** argv)
+{
+    const char* path = argc > 0 ? argv[0] : GOLDEN_DEFAULT_PATH;
+    const char* diffDir = argc > 1 ? argv[1] : ".";
+
+    static GoldenEntry golden[64];
+    int goldenCount = loadGolden(path, golden, 64);
+    if (goldenCount < 0)
+    {
+        return 1;
+    }
+
+    GoldenCase cases[32];
+    int count = goldenCases(cases);
+    int failed = 0, checks = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const GoldenEntry* entry = nullptr;
+        for (int j = 0; j < goldenCount && !entry; j++)
+        {
+            entry = strcmp(golden[j].name, cases[i].name) == 0 ? &golden[j] : nullptr;
+        }
+        if (!entry)
+        {
+            printf("FAIL %s: no golden entry\n", cases[i].name);
+            failed++;
+            checks++;
+            continue;
+        }
+
+        FrameHash hash;
+        renderDirect(cases[i], hash);
+        failed += compare(cases[i].name, *entry, hash, diffDir) ? 0 : 1;
+        checks++;
+
+        char label[64];
+        if (cases[i].capture)
+        {
+            snprintf(label, sizeof(label), "%s.cached", cases[i].name);
+            renderCached(cases[i], hash);
+            failed += compare(label, *entry, hash, diffDir) ? 0 : 1;
+            checks++;
+        }
+
+        snprintf(label, sizeof(label), "%s.buffered", cases[i].name);
+        renderBuffered(cases[i], hash);
+        failed += compare(label, *entry, hash, diffDir) ? 0 : 1;
+        checks++;
+    }
+    printf("%d of %d checks failed\n", failed, checks);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+#include "tool.h"
+
+/*  Feeds temperature ramps through simulated motors into MotorHealth,
+    one sample() per MOTORHEALTH_PERIOD_MS of virtual time, and checks the
+    levels it reports: each phase must call the listener with exactly the
+    level changes expected, in order, and end on the level expected. One
+    phase watches a third motor halfway through: the motors already
+    watched must keep their averages and levels. */
+
+#define HEALTH_DT (MOTORHEALTH_PERIOD_MS / 1000.0f)
+#define HEALTH_MAX_EVENTS 8
+
+struct HealthEvent
+{
+    int motor;
+    HealthLevel level;
+};
+
+static HealthEvent events[64];
+static int eventCount = 0;
+
+static void recordEvent(int motor, HealthLevel level)
+{
+    if (eventCount < (int)(sizeof(events) / sizeof(events[0])))
+    {
+        events[eventCount].motor = motor;
+        events[eventCount].level = level;
+    }
+    eventCount++;
+}
+
+struct HealthPhase
+{
+    const char* what;
+    float from, to;         // L1 ramps from, to (C) over the ramp samples
+    int ramp, hold;         // samples ramping, then holding at "to"
+    float jitter;           // +- added to every other reading while holding
+    HealthEvent expected[HEALTH_MAX_EVENTS];
+    int expectedCount;
+    HealthLevel end;        // L1's level after the phase
+};
+
+static const HealthPhase phases[] =
+{
+    { "idle at 25 C",        25, 25,   0, 100, 0, { },                                  0, HEALTH_OK },
+    { "heat to 60 C",        25, 60, 300, 100, 0, { { 0, HEALTH_WARM }, { 0, HEALTH_HOT } }, 2, HEALTH_HOT },
+    { "hover at the limit",  55, 55,   0, 200, 1, { },                                  0, HEALTH_HOT },
+    { "cool to 25 C",        55, 25, 300, 600, 0, { { 0, HEALTH_WARM }, { 0, HEALTH_OK } }, 2, HEALTH_OK },
+};
+static const int phaseCount = sizeof(phases) / sizeof(phases[0]);
+
+static const char* levelName(int level)
+{
+    return level == HEALTH_HOT ? "hot" : level == HEALTH_WARM ? "warm" : "ok";
+}
+
+static void setTemperature(motor& m, float temperature)
+{
+    sim::setMotor(m.index(), temperature, 0);
+}
+
+int healthCommand(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    MotorHealth::reset();
+    MotorHealth::subscribe(recordEvent);
+    setTemperature(L1, 25);
+    setTemperature(L2, 25);
+    MotorHealth::watch(L1, "L1");
+    MotorHealth::watch(L2, "L2");
+
+    int failed = 0;
+    for (int p = 0; p < phaseCount; p++)
+    {
+        const HealthPhase& phase = phases[p];
+        eventCount = 0;
+        bool ok = true;
+        for (int s = 0; s < phase.ramp + phase.hold; s++)
+        {
+            float t = s < phase.ramp ? phase.from + (phase.to - phase.from) * (s + 1) / phase.ramp :
+                      phase.to + (s % 2 ? phase.jitter : -phase.jitter);
+            setTemperature(L1, t);
+            MotorHealth::sample(HEALTH_DT);
+
+            // halfway through the hover, watch another motor while L1
+            // reads a spike: L1's average must not restart from it
+            if (phase.jitter && s == phase.hold / 2)
+            {
+                double before = MotorHealth::temperature(0);
+                setTemperature(L1, phase.to + 15);
+                setTemperature(L3, 30);
+                int added = MotorHealth::watch(L3, "L3");
+                MotorHealth::sample(HEALTH_DT);
+                double after = MotorHealth::temperature(0);
+                if (added != 2 || MotorHealth::temperature(added) != 30.0 ||
+                    after < before - 1.0 || after > before + 1.0 || MotorHealth::level(0) != HEALTH_HOT)
+                {
+                    printf("  watching L3 moved L1 from %.1f C to %.1f C (%s), L3 at %.1f C\n",
+                           before, after, levelName(MotorHealth::level(0)), MotorHealth::temperature(added));
+                    ok = false;
+                }
+            }
+        }
+
+        ok = ok && eventCount == phase.expectedCount;
+        for (int e = 0; ok && e < eventCount; e++)
+        {
+            ok = events[e].motor == phase.expected[e].motor && events[e].level == phase.expected[e].level;
+        }
+        ok = ok && MotorHealth::level(0) == phase.end && MotorHealth::level(1) == HEALTH_OK;
+        printf("%-20s L1 %5.1f C %-4s %d listener calls  %s\n", phase.what, MotorHealth::temperature(0),
+               levelName(MotorHealth::level(0)), eventCount, ok ? "ok" : "FAILED");
+        if (!ok)
+        {
+            printf("  calls:");
+            for (int e = 0; e < eventCount && e < 64; e++)
+            {
+                printf(" %s %s", MotorHealth::name(events[e].motor), levelName(events[e].level));
+            }
+            printf("\n  expected:");
+            for (int e = 0; e < phase.expectedCount; e++)
+            {
+                printf(" %s %s", MotorHealth::name(phase.expected[e].motor), levelName(phase.expected[e].level));
+            }
+            printf(", ending %s\n", levelName(phase.end));
+            failed++;
+        }
+    }
+    printf("%u samples, %u level changes\n", MotorHealth::sampleCount(), MotorHealth::alertCount());
+    printf("%d of %d health phases failed\n", failed, phaseCount);
+    MotorHealth::reset();
+    return failed ? 1 : 0;
+}
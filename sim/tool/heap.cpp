@@ -0,0 +1,109 @@
+#include "tool.h"
+
+/*  Taps through every screen of the built-in menu and back to Home, over
+    and over, and checks that the heap stays flat: after one warm-up tour
+    (the render buffer, the glyph atlases and the first snapshots are
+    allocated once), the bytes and blocks live at the end of every tour
+    must be the same. Each tap is one navigation and must reach the screen
+    expected, as MonitorStep() reports it. A tour ends on Home with an
+    empty history, so at most Home's own snapshot may be left: frames kept
+    by screens that were left behind would pin the snapshot budget. */
+
+struct HeapTap
+{
+    int x, y;
+    const char* screen;     // active once the tap is handled
+};
+
+static const HeapTap tour[] =
+{
+    { 400,  40, "Heading" }, { 400, 185, "Home" },
+    { 400,  95, "Ports" },   { 400, 185, "Home" },
+    { 400, 150, "Auton" },   { 295,  60, "Red" },    { 400, 185, "Home" },
+    { 400, 150, "Auton" },   { 295, 140, "Blue" },   { 400, 185, "Home" },
+    { 400, 210, "Util" },    { 240,  60, "Logo" },   { 400, 185, "Home" },
+    { 400, 210, "Util" },    { 240, 190, "Perf" },   { 415, 210, "Util" },   { 420, 185, "Home" },
+    { 400, 210, "Util" },    { 130, 125, "Field" },  { 415, 210, "Util" },   { 420, 185, "Home" },
+};
+static const int tourLength = sizeof(tour) / sizeof(tour[0]);
+
+// one tour; false (with a message) if a tap did not reach its screen
+static bool runTour(int number)
+{
+    for (int i = 0; i < tourLength; i++)
+    {
+        sim::tap(tour[i].x, tour[i].y);
+        MonitorStep();      // reset() picks up the touch
+        MonitorStep();      // the active interface handles it
+        const char* screen = UIState::getScreen();
+        if (!screen || strcmp(screen, tour[i].screen) != 0)
+        {
+            fprintf(stderr, "tour %d, tap %d at %d,%d: on %s, expected %s\n", number, i + 1,
+                    tour[i].x, tour[i].y, screen ? screen : "no screen", tour[i].screen);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void printReport(const char* title)
+{
+    char text[(HEAP_TAGS + 2) * HEAP_REPORT_LINE];
+    HeapTracker::report(text, sizeof(text));
+    printf("%s\n%s", title, text);
+}
+
+int heapCommand(int argc, char** argv)
+{
+    int navigations = argc > 0 ? atoi(argv[0]) : 10000;
+    navigations = navigations > 0 ? navigations : 10000;
+    int tours = (navigations + tourLength - 1) / tourLength;
+    if (!HeapTracker::isEnabled())
+    {
+        fprintf(stderr, "heap: built without WLIC_TRACK_MEMORY\n");
+        return 1;
+    }
+
+    sim::reset();
+    MonitorSetup();
+    if (!runTour(0))
+    {
+        sim::stopAllTasks();
+        return 1;
+    }
+    HeapStats warm = HeapTracker::getStats();
+    HeapTracker::resetPeak();
+    printReport("after the warm-up tour:");
+
+    bool ok = true;
+    uint32_t lowest = warm.bytes, highest = warm.bytes;
+    for (int t = 1; t <= tours && ok; t++)
+    {
+        ok = runTour(t);
+        HeapStats now = HeapTracker::getStats();
+        lowest = now.bytes < lowest ? now.bytes : lowest;
+        highest = now.bytes > highest ? now.bytes : highest;
+        if (ok && (NavHistory::depth() != 0 || NavHistory::getSnapshotBytes() > FRAME_BYTES))
+        {
+            fprintf(stderr, "tour %d: back on Home with %d screens in the history and %lu "
+                    "snapshot bytes\n", t, NavHistory::depth(), (unsigned long)NavHistory::getSnapshotBytes());
+            ok = false;
+        }
+        if (ok && (now.bytes != warm.bytes || now.blocks != warm.blocks))
+        {
+            fprintf(stderr, "tour %d: %lu bytes in %lu blocks live, %lu in %lu after the warm-up\n", t,
+                    (unsigned long)now.bytes, (unsigned long)now.blocks,
+                    (unsigned long)warm.bytes, (unsigned long)warm.blocks);
+            ok = false;
+        }
+    }
+    sim::stopAllTasks();
+
+    HeapStats end = HeapTracker::getStats();
+    printReport("after the last tour:");
+    printf("%d navigations in %d tours: %lu allocations, live bytes at tour ends %lu..%lu, "
+           "peak %lu\n", tours * tourLength, tours, (unsigned long)(end.allocations - warm.allocations),
+           (unsigned long)lowest, (unsigned long)highest, (unsigned long)end.peak);
+    printf("heap %s\n", ok ? "flat" : "NOT flat");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "tool.h"
+
+/*  Runs the real Monitor() loop in real time with a short idle timeout,
+    leaves the Brain alone until it goes idle and for a while after, then
+    taps the Heading button. Reports the draw calls per second in each
+    mode, the passes skipped while idle and how long the tap took to wake
+    the menu. */
+
+static double drawRate(uint64_t since)
+{
+    double seconds = (nowNanos() - since) / 1e9;
+    return seconds > 0 ? sim::drawStats().drawCalls / seconds : 0;
+}
+
+int idleCommand(int argc, char** argv)
+{
+    uint32_t timeoutMs = argc > 0 ? (uint32_t)atoi(argv[0]) : 2000;
+    int idleSeconds = argc > 1 ? atoi(argv[1]) : 5;
+
+    sim::reset();
+    sim::setTimeScale(1.0);     // idle is about real time
+    IdlePolicy::reset();
+    IdlePolicy::setTimeout(timeoutMs);
+    task* monitor = new task(Monitor);
+
+    // active until the timeout, leaving out the first draw of Home
+    wait(200, msec);
+    uint64_t start = nowNanos();
+    sim::resetDrawStats();
+    while (!IdlePolicy::isIdle() && nowNanos() - start < (timeoutMs + 2000) * 1000000ull)
+    {
+        wait(10, msec);
+    }
+    double activeRate = drawRate(start);
+    double wentIdle = (nowNanos() - start) / 1e6 + 200;
+    bool slept = IdlePolicy::isIdle();
+
+    start = nowNanos();
+    sim::resetDrawStats();
+    wait(idleSeconds * 1000, msec);
+    double idleRate = drawRate(start);
+
+    // the Heading button on Home
+    sim::tap(400, 40);
+    uint64_t tapped = nowNanos();
+    while (IdlePolicy::isIdle() && nowNanos() - tapped < 2000000000ull)
+    {
+        wait(1, msec);
+    }
+    double latency = (nowNanos() - tapped) / 1e6;
+    bool woke = !IdlePolicy::isIdle();
+
+    sim::stopAllTasks();
+    delete monitor;
+    sim::setTimeScale(0);
+
+    IdleStats stats = IdlePolicy::getStats();
+    printf("went idle after %.0f ms (timeout %u ms)\n", wentIdle, timeoutMs);
+    printf("draw calls per second: %.1f active, %.1f idle\n", activeRate, idleRate);
+    printf("%u ms active, %u ms idle, %u passes skipped\n", stats.activeMs, stats.idleMs, stats.skipped);
+    printf("tap %s the menu in %.1f ms\n", woke ? "woke" : "did NOT wake", latency);
+    return slept && woke ? 0 : 1;
+}
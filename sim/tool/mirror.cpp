@@ -0,0 +1,95 @@
+#include "tool.h"
+
+/*  Steps ControllerMirror by hand through a list of row changes and checks
+    what reached the simulated controller: after each change the mirror is
+    stepped until it has nothing left to write, and the writes and cells
+    counted by getStats() must be the ones expected, with the rows shown
+    matching the text asked for. The writer task is stopped, so only
+    step() writes. */
+
+struct MirrorCase
+{
+    const char* what;
+    const char* rows[MIRROR_ROWS];     // null leaves a row as it is
+    uint32_t writes, cells;
+};
+
+static const MirrorCase cases[] =
+{
+    { "first text",               { "Home", nullptr, nullptr },                  1,  4 },
+    { "row unchanged",            { "Home", nullptr, nullptr },                  0,  0 },
+    { "new row",                  { nullptr, "Heading 123.4", nullptr },         1, 13 },
+    { "one digit in the middle",  { nullptr, "Heading 124.4", nullptr },         1,  1 },
+    { "digits apart",             { nullptr, "Heading 133.5", nullptr },         1,  4 },
+    { "shorter text",             { nullptr, "Heading", nullptr },               1,  5 },
+    { "row cleared",              { "", nullptr, nullptr },                      1,  4 },
+    { "two rows",                 { "Auton", nullptr, "Red 1" },                 2, 10 },
+    { "too long, cut",            { nullptr, nullptr, "Red 1 then park by the goal" }, 1, 12 },
+    { "every row cleared",        { "", "", "" },                                3, 30 },
+};
+static const int caseCount = sizeof(cases) / sizeof(cases[0]);
+
+int mirrorCommand(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    // start() clears the controller and sets the target; step by hand
+    ControllerMirror::start(Controller);
+    ControllerMirror::stop();
+
+    char wanted[MIRROR_ROWS][MIRROR_COLUMNS + 1];
+    for (int row = 0; row < MIRROR_ROWS; row++)
+    {
+        memset(wanted[row], ' ', MIRROR_COLUMNS);
+        wanted[row][MIRROR_COLUMNS] = 0;
+    }
+
+    int failed = 0;
+    for (int i = 0; i < caseCount; i++)
+    {
+        const MirrorCase& c = cases[i];
+        for (int row = 0; row < MIRROR_ROWS; row++)
+        {
+            if (c.rows[row])
+            {
+                ControllerMirror::setLine(row, c.rows[row]);
+                int length = (int)strlen(c.rows[row]);
+                length = length < MIRROR_COLUMNS ? length : MIRROR_COLUMNS;
+                memset(wanted[row], ' ', MIRROR_COLUMNS);
+                memcpy(wanted[row], c.rows[row], length);
+            }
+        }
+
+        MirrorStats before = ControllerMirror::getStats();
+        uint32_t prints = sim::controllerWrites();
+        int steps = 0;
+        while (ControllerMirror::step() && steps <= MIRROR_ROWS)
+        {
+            steps++;
+        }
+        MirrorStats after = ControllerMirror::getStats();
+        uint32_t writes = after.writes - before.writes;
+        uint32_t cells = after.cells - before.cells;
+
+        bool ok = writes == c.writes && cells == c.cells && (int)writes == steps &&
+                  sim::controllerWrites() - prints == writes;
+        for (int row = 0; row < MIRROR_ROWS; row++)
+        {
+            if (strncmp(sim::controllerLine(row), wanted[row], MIRROR_COLUMNS) != 0)
+            {
+                printf("  row %d shows \"%.*s\", expected \"%s\"\n", row, MIRROR_COLUMNS,
+                       sim::controllerLine(row), wanted[row]);
+                ok = false;
+            }
+        }
+        printf("%-24s %u writes, %2u cells  %s\n", c.what, writes, cells, ok ? "ok" : "FAILED");
+        if (!ok)
+        {
+            printf("  expected %u writes and %u cells\n", c.writes, c.cells);
+            failed++;
+        }
+    }
+    printf("%d of %d mirror cases failed\n", failed, caseCount);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+#include "tool.h"
+
+#include <thread>
+
+/*  Plugs and unplugs simulated devices under PortMap and checks that each
+    draw() redraws only the cells of the ports that changed: poll() must
+    report the ports changed, draw() must redraw that many cells, every
+    pixel that differs afterwards must lie in one of their cells (labels
+    included), and each
+    of those cells must show its new status color. PortMap is driven
+    directly, without the menu, so nothing else draws meanwhile. */
+
+// the cell layout and colors of portmap.cpp
+#define CELL_LEFT   49
+#define CELL_TOP    52
+#define CELL_STEP_X 50
+#define CELL_STEP_Y 54
+
+// the simulator fills text boxes with mono20 metrics, so a cell's labels
+// reach a little past its square; still well short of the next cell
+#define LABEL_MARGIN_X 10
+#define LABEL_MARGIN_Y 5
+
+static const uint32_t statusColors[] =
+{
+    0x6E6E6E, 0x2E9E44, 0xD03030, 0xE08A1E, 0x3070C0
+};
+
+static void cellPosition(int port, int& x, int& y)
+{
+    int row = port < 8 ? 0 : (port < 15 ? 1 : 2);
+    int column = port - (row == 0 ? 0 : (row == 1 ? 8 : 15));
+    x = CELL_LEFT + column * CELL_STEP_X;
+    y = CELL_TOP + row * CELL_STEP_Y;
+}
+
+static int cellAt(int x, int y)
+{
+    for (int port = 0; port < PORTMAP_PORTS; port++)
+    {
+        int cx, cy;
+        cellPosition(port, cx, cy);
+        if (x >= cx && x < cx + PORTMAP_CELL + LABEL_MARGIN_X &&
+            y >= cy - LABEL_MARGIN_Y && y < cy + PORTMAP_CELL + LABEL_MARGIN_Y)
+        {
+            return port;
+        }
+    }
+    return -1;
+}
+
+// scan as soon as PORTMAP_POLL_MS allows; the number of ports changed
+static int scan()
+{
+    int changed = PortMap::poll();
+    for (int i = 0; i < 100 && changed < 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        changed = PortMap::poll();
+    }
+    return changed;
+}
+
+struct PortChange
+{
+    int port;               // zero-based, -1 ends the list
+    V5_DeviceType type;
+};
+
+struct PortCase
+{
+    const char* what;
+    PortChange changes[3];
+    int cells;              // ports whose cell must be redrawn
+};
+
+static const PortCase cases[] =
+{
+    { "nothing changed",       { { -1 } },                                                      0 },
+    { "imu unplugged",         { { 0, kDeviceTypeNoSensor }, { -1 } },                          1 },
+    { "motor in the imu port", { { 0, kDeviceTypeMotorSensor }, { -1 } },                       1 },
+    { "extra device",          { { 2, kDeviceTypeDistanceSensor }, { -1 } },                    1 },
+    { "same device again",     { { 2, kDeviceTypeDistanceSensor }, { -1 } },                    0 },
+    { "two motors unplugged",  { { 8, kDeviceTypeNoSensor }, { 19, kDeviceTypeNoSensor }, { -1 } }, 2 },
+    { "all plugged back",      { { 0, kDeviceTypeImuSensor }, { 2, kDeviceTypeNoSensor },
+                                 { 8, kDeviceTypeMotorSensor } },                               3 },
+    { "last motor back",       { { 19, kDeviceTypeMotorSensor }, { -1 } },                      1 },
+};
+static const int caseCount = sizeof(cases) / sizeof(cases[0]);
+
+int portsCommand(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    // the robot-config devices, expected and plugged in
+    motor* motors[] = { &L1, &L2, &L3, &R1, &R2, &R3 };
+    for (motor* m : motors)
+    {
+        PortMap::expect(*m);
+        sim::setDevice(m->index(), kDeviceTypeMotorSensor);
+    }
+    PortMap::expect(gyro1);
+    sim::setDevice(gyro1.index(), kDeviceTypeImuSensor);
+
+    sim::reset();
+    scan();
+    PortMap::invalidate();
+    int drawn = PortMap::draw();
+    bool allOk = drawn == PORTMAP_PORTS;
+    printf("%-22s %2d cells  %s\n", "first draw", drawn, allOk ? "ok" : "FAILED");
+
+    static uint32_t before[sim::WIDTH * sim::HEIGHT];
+    int failed = allOk ? 0 : 1;
+    for (int i = 0; i < caseCount; i++)
+    {
+        const PortCase& c = cases[i];
+        memcpy(before, sim::framebuffer(), sizeof(before));
+        bool affected[PORTMAP_PORTS] = {};
+        for (int j = 0; j < 3 && c.changes[j].port >= 0; j++)
+        {
+            sim::setDevice(c.changes[j].port, c.changes[j].type);
+            affected[c.changes[j].port] = true;
+        }
+
+        int changed = scan();
+        sim::resetDrawStats();
+        int cells = PortMap::draw();
+        bool ok = changed == c.cells && cells == c.cells;
+        if (c.cells == 0 && sim::drawStats().drawCalls != 0)
+        {
+            printf("  %lu draw calls with nothing to redraw\n", (unsigned long)sim::drawStats().drawCalls);
+            ok = false;
+        }
+
+        // every pixel drawn must be in the cell of a changed port
+        const uint32_t* after = sim::framebuffer();
+        int stray = 0;
+        for (int p = 0; p < sim::WIDTH * sim::HEIGHT; p++)
+        {
+            if (after[p] != before[p])
+            {
+                int port = cellAt(p % sim::WIDTH, p / sim::WIDTH);
+                stray += port < 0 || !affected[port];
+            }
+        }
+        if (stray)
+        {
+            printf("  %d pixels changed outside the cells of the ports changed\n", stray);
+            ok = false;
+        }
+        for (int port = 0; port < PORTMAP_PORTS; port++)
+        {
+            int x, y;
+            cellPosition(port, x, y);
+            uint32_t color = sim::pixel(x + PORTMAP_CELL - 2, y + PORTMAP_CELL - 2);
+            if (affected[port] && color != statusColors[PortMap::getStatus(port)])
+            {
+                printf("  port %d shows #%06X, not the color of status %d\n", port + 1,
+                       (unsigned)color, (int)PortMap::getStatus(port));
+                ok = false;
+            }
+        }
+
+        printf("%-22s %2d cells  %s\n", c.what, cells, ok ? "ok" : "FAILED");
+        if (!ok)
+        {
+            printf("  expected %d ports changed and redrawn, poll() saw %d\n", c.cells, changed);
+            failed++;
+        }
+    }
+    PortMapStats stats = PortMap::getStats();
+    printf("%u scans, %u port changes, %u cells drawn\n", stats.scans, stats.changes, stats.cellsDrawn);
+    printf("%d of %d port map cases failed\n", failed, caseCount + 1);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,346 @@
+#include "tool.h"
+
+/*  Replays an InputRecorder log into the built-in menu in virtual time:
+    every 100 ms of recorded time is one MonitorStep() (the Brain's loop
+    period), so a session runs the same way each time, as fast as the
+    host allows. Sensor events are applied to the simulated devices
+    before the step they fall in; each release becomes one tap. */
+
+#define REPLAY_STEP_MS 100
+#define REPLAY_MAX_IDLE_STEPS 50       // cap long idle gaps at 5 s
+
+static int loadLog(const char* path, InputRecord** records)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return -1;
+    }
+    InputLogHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != INPUT_LOG_MAGIC ||
+        header.version != INPUT_LOG_VERSION || header.recordSize != sizeof(InputRecord))
+    {
+        fprintf(stderr, "%s is not a version %d input log\n", path, INPUT_LOG_VERSION);
+        fclose(file);
+        return -1;
+    }
+    *records = new InputRecord[header.count ? header.count : 1];
+    int count = (int)fread(*records, sizeof(InputRecord), header.count, file);
+    fclose(file);
+    if (count != (int)header.count)
+    {
+        fprintf(stderr, "%s: truncated, replaying %d of %u records\n", path, count, header.count);
+    }
+    return count;
+}
+
+static void printHistogram(const char* label, const Histogram& h)
+{
+    printf("  %-10s n=%-5u p50=%-6u p95=%-6u max=%u\n", label,
+           h.count(), h.percentile(50), h.percentile(95), h.max());
+}
+
+struct ReplayRun
+{
+    int steps, taps;
+    uint32_t clock;                     // recorded time reached (ms)
+    std::vector<std::string> screens;   // active after each tap
+};
+
+// feed records into the menu set up already, step by step
+static void replaySession(const InputRecord* records, int count, ReplayRun& run)
+{
+    double temperature[21], voltage[21];
+    for (int p = 0; p < 21; p++)
+    {
+        temperature[p] = 25.0;
+        voltage[p] = 0.0;
+    }
+
+    run.steps = run.taps = 0;
+    run.clock = 0;
+    run.screens.clear();
+    for (int i = 0; i < count; i++)
+    {
+        const InputRecord& r = records[i];
+
+        // run the loop up to the event, as the Brain would have
+        int idle = 0;
+        while (run.clock + REPLAY_STEP_MS <= r.time)
+        {
+            if (idle++ < REPLAY_MAX_IDLE_STEPS)
+            {
+                MonitorStep();
+                run.steps++;
+            }
+            run.clock += REPLAY_STEP_MS;
+        }
+
+        int port = r.port < 21 ? r.port : 0;
+        switch (r.type)
+        {
+            case INPUT_HEADING:
+                sim::setHeading(port, r.value / 10.0);
+                break;
+            case INPUT_MOTOR_TEMP:
+                temperature[port] = r.value / 10.0;
+                sim::setMotor(port, temperature[port], voltage[port]);
+                break;
+            case INPUT_MOTOR_VOLT:
+                voltage[port] = r.value / 1000.0;
+                sim::setMotor(port, temperature[port], voltage[port]);
+                break;
+            case INPUT_TOUCH_RELEASE:
+            {
+                sim::tap(r.x, r.y);
+                MonitorStep();      // reset() reads the touch
+                MonitorStep();      // the active interface handles it
+                run.steps += 2;
+                run.clock += 2 * REPLAY_STEP_MS;
+                run.taps++;
+                const char* screen = UIState::getScreen();
+                run.screens.push_back(screen ? screen : "");
+                break;
+            }
+            default:
+                break;              // presses only mark latency start on the Brain
+        }
+    }
+}
+
+int replayCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: replay <log> [out.ppm]\n");
+        return 2;
+    }
+    InputRecord* records = nullptr;
+    int count = loadLog(argv[0], &records);
+    if (count < 0)
+    {
+        return 1;
+    }
+
+    Perf::setEnabled(true);
+    MonitorSetup();
+
+    uint64_t start = nowNanos();
+    ReplayRun run;
+    replaySession(records, count, run);
+    double seconds = (nowNanos() - start) / 1e9;
+    sim::stopAllTasks();
+
+    printf("replayed %d records (%d taps) from %s\n", count, run.taps, argv[0]);
+    printf("  %d loop steps, %.1f s recorded, %.3f s on host\n", run.steps, run.clock / 1000.0, seconds);
+    printHistogram("touch", Perf::touchLatency());
+    for (int i = 0; Perf::screen(i); i++)
+    {
+        const Perf::Screen* screen = Perf::screen(i);
+        const char* name = screen->name.load();
+        printHistogram(name ? name : "?", screen->draw);
+    }
+    delete[] records;
+
+    if (argc > 1 && !sim::savePPM(argv[1]))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
+
+/*  Records a scripted session with the InputRecorder, saves the log to the
+    simulated SD card, then replays it from there into a fresh menu: each
+    tap must land on the screen it reached while recording, and the heading
+    changes made between taps must come back too. Both runs boot to Home:
+    the menu state saved in the SD directory is removed first. Without taps
+    given, several scripts run; the short ones end on a tap that hits a
+    Home button, which the fresh menu of the replay must not act on before
+    the log reaches it. */
+
+#define RECORD_LOG_FILE "session.wlir"
+
+struct RecordTap
+{
+    int x, y;
+};
+
+static const RecordTap tourScript[] =
+{
+    { 400,  40 }, { 400, 185 },                 // Heading, Home
+    { 400, 150 }, { 295,  60 }, { 400, 185 },   // Auton, Red, Home
+    { 400, 210 }, { 240, 190 }, { 415, 210 },   // Util, Perf, Back to Util
+    { 420, 185 }, { 400,  40 }, { 400, 185 },   // Home, Heading, Home
+};
+static const RecordTap utilScript[] =
+{
+    { 400, 200 },                               // Util
+};
+static const RecordTap missScript[] =
+{
+    { 100, 100 }, { 400, 200 },                 // no button, Util
+};
+static const RecordTap fieldScript[] =
+{
+    { 400, 210 }, { 130, 125 }, { 415, 210 },   // Util, Field, Back to Util
+};
+
+struct RecordScript
+{
+    const char* name;
+    const RecordTap* taps;
+    int count;
+};
+
+#define RECORD_SCRIPT(name, taps) { name, taps, sizeof(taps) / sizeof(taps[0]) }
+static const RecordScript recordScripts[] =
+{
+    RECORD_SCRIPT("tour", tourScript),
+    RECORD_SCRIPT("util", utilScript),
+    RECORD_SCRIPT("miss", missScript),
+    RECORD_SCRIPT("field", fieldScript),
+};
+
+static void removeUIState()
+{
+    char path[512];
+    for (int slot = 0; slot < 2; slot++)
+    {
+        snprintf(path, sizeof(path), "%s/%s.%d", sim::sdRoot(), UI_STATE_FILE, slot);
+        remove(path);
+    }
+}
+
+// turn the robot and wait for the sampler to log it
+static bool turnTo(double heading)
+{
+    int logged = InputRecorder::size();
+    sim::setHeading(gyro1.index(), heading);
+    for (int i = 0; i < 1000 && InputRecorder::size() == logged; i++)
+    {
+        wait(1, msec);
+    }
+    return InputRecorder::size() > logged;
+}
+
+// record, save, load and replay one script; false (with messages) if it differs
+static bool roundTrip(const char* name, const RecordTap* script, int taps)
+{
+    // record: every fourth tap, and once at the end, turn the robot
+    removeUIState();
+    sim::reset();
+    sim::setHeading(gyro1.index(), 0);
+    MonitorSetup();
+    InputRecorder::start(10);
+    std::vector<std::string> recorded;
+    bool ok = true;
+    for (int i = 0; i < taps && ok; i++)
+    {
+        if (i > 0 && i % 4 == 0)
+        {
+            ok = turnTo(i * 15.0);
+        }
+        sim::tap(script[i].x, script[i].y);
+        MonitorStep();      // reset() reads and logs the touch
+        MonitorStep();      // the active interface handles it
+        const char* screen = UIState::getScreen();
+        recorded.push_back(screen ? screen : "");
+    }
+    ok = ok && turnTo(275.0);
+    InputRecorder::stop();
+    sim::stopAllTasks();
+    double heading = gyro1.heading(degrees);
+    int logged = InputRecorder::size();
+    if (!ok)
+    {
+        fprintf(stderr, "record %s: the sampler did not log a heading change\n", name);
+        return false;
+    }
+    if (!InputRecorder::save(RECORD_LOG_FILE))
+    {
+        fprintf(stderr, "record %s: cannot save %s to %s\n", name, RECORD_LOG_FILE, sim::sdRoot());
+        return false;
+    }
+
+    // replay what the SD card holds into a fresh menu
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", sim::sdRoot(), RECORD_LOG_FILE);
+    InputRecord* records = nullptr;
+    int count = loadLog(path, &records);
+    if (count < 0)
+    {
+        return false;
+    }
+    removeUIState();
+    sim::reset();
+    sim::setHeading(gyro1.index(), 0);
+    MonitorSetup();
+    ReplayRun run;
+    replaySession(records, count, run);
+    sim::stopAllTasks();
+    delete[] records;
+
+    if (count != logged)
+    {
+        printf("%s: saved %d records, read back %d\n", name, logged, count);
+        ok = false;
+    }
+    for (size_t i = 0; i < recorded.size() || i < run.screens.size(); i++)
+    {
+        const char* was = i < recorded.size() ? recorded[i].c_str() : "no tap";
+        const char* now = i < run.screens.size() ? run.screens[i].c_str() : "no tap";
+        if (strcmp(was, now) != 0)
+        {
+            printf("%s, tap %d: recorded on %s, replayed on %s\n", name, (int)i + 1, was, now);
+            ok = false;
+        }
+    }
+    if (gyro1.heading(degrees) != heading)
+    {
+        printf("%s: heading recorded %.1f, replayed %.1f\n", name, heading, gyro1.heading(degrees));
+        ok = false;
+    }
+    printf("%-6s %2d taps in %3d records, replayed %2d taps ending on %-8s %s\n", name,
+           (int)recorded.size(), logged, run.taps, run.screens.empty() ? "Home" :
+           run.screens.back().c_str(), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int recordCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: record <sd dir> [x,y ...]\n");
+        return 2;
+    }
+    std::vector<RecordTap> script;
+    for (int i = 1; i < argc; i++)
+    {
+        RecordTap tap;
+        if (sscanf(argv[i], "%d,%d", &tap.x, &tap.y) != 2)
+        {
+            fprintf(stderr, "record: expected x,y, got %s\n", argv[i]);
+            return 2;
+        }
+        script.push_back(tap);
+    }
+    sim::setSDRoot(argv[0]);
+    InputRecorder::watch(gyro1);        // once: watch() adds to a list
+
+    bool ok = true;
+    if (!script.empty())
+    {
+        ok = roundTrip("taps", &script[0], (int)script.size());
+    }
+    else
+    {
+        for (const RecordScript& s : recordScripts)
+        {
+            ok = roundTrip(s.name, s.taps, s.count) && ok;
+        }
+    }
+    printf("record %s\n", ok ? "round-trip OK" : "round-trip FAILED");
+    return ok ? 0 : 1;
+}
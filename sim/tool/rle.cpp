@@ -0,0 +1,256 @@
+#include "tool.h"
+
+#include <map>
+#include <string>
+
+/*  Checks the run expander behind drawImageRLE() against a plain
+    pixel-by-pixel decoder, then times both. The runs of each built-in
+    screen are taken from the screen as drawn (touching pixels of one
+    color make one run, across row ends like the converter's), so the
+    run lengths are those of the real images. Random tables add skip
+    runs, runs past the last row and every alignment of fillPixels(). */
+
+struct RunTable
+{
+    std::vector<std::string> names;
+    std::vector<const char*> colors;
+    std::vector<int> indices;
+    std::vector<int> counts;
+};
+
+// the scalar decoder expandImageRLE() must match
+static int referenceExpand(const RunTable& t, uint32_t* frame)
+{
+    int x = 0, y = 0, covered = 0;
+    for (size_t i = 0; i < t.indices.size(); i++)
+    {
+        int index = t.indices[i];
+        uint32_t pixel = index >= 0 ? parseColor(t.colors[index]) : 0;
+        for (int j = 0; j < t.counts[i]; j++)
+        {
+            if (y >= SCREEN_HEIGHT)
+            {
+                return covered;
+            }
+            if (index >= 0)
+            {
+                frame[y * SCREEN_WIDTH + x] = pixel;
+            }
+            covered++;
+            if (++x == SCREEN_WIDTH)
+            {
+                x = 0;
+                y++;
+            }
+        }
+    }
+    return covered;
+}
+
+static int libraryExpand(const RunTable& t, uint32_t* frame)
+{
+    return expandImageRLE(t.colors.data(), t.indices.data(), t.counts.data(), (int)t.indices.size(), frame);
+}
+
+static int addColor(RunTable& t, std::map<uint32_t, int>& palette, uint32_t rgb)
+{
+    std::map<uint32_t, int>::iterator found = palette.find(rgb);
+    if (found != palette.end())
+    {
+        return found->second;
+    }
+    char hex[8];
+    snprintf(hex, sizeof(hex), "#%06x", rgb & 0xFFFFFF);
+    t.names.push_back(hex);
+    palette[rgb] = (int)t.names.size() - 1;
+    return palette[rgb];
+}
+static void finishTable(RunTable& t)
+{
+    t.colors.clear();
+    for (const std::string& name : t.names)
+    {
+        t.colors.push_back(name.c_str());
+    }
+}
+
+static void tableFromScreen(RunTable& t, const uint32_t* pixels)
+{
+    std::map<uint32_t, int> palette;
+    const int total = SCREEN_WIDTH * SCREEN_HEIGHT;
+    for (int i = 0; i < total; )
+    {
+        int length = 1;
+        while (i + length < total && pixels[i + length] == pixels[i])
+        {
+            length++;
+        }
+        t.indices.push_back(addColor(t, palette, pixels[i]));
+        t.counts.push_back(length);
+        i += length;
+    }
+    finishTable(t);
+}
+
+static uint32_t rngState = 12345;
+static uint32_t rng()
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void randomTable(RunTable& t)
+{
+    std::map<uint32_t, int> palette;
+    int total = 0;
+    int limit = SCREEN_WIDTH * SCREEN_HEIGHT + 2000;    // some runs past the last row
+    while (total < limit)
+    {
+        int length = rng() % 4 == 0 ? 1 + rng() % 700 : 1 + rng() % 12;
+        bool skip = rng() % 5 == 0;
+        t.indices.push_back(skip ? -1 : addColor(t, palette, rng() % 16 * 0x111111));
+        t.counts.push_back(length);
+        total += length;
+    }
+    finishTable(t);
+}
+
+// decodes over a patterned frame so skip runs that write show up
+static bool sameExpansion(const RunTable& t, uint32_t* expected, uint32_t* actual)
+{
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    {
+        expected[i] = actual[i] = 0xA5000000 | i;
+    }
+    int a = referenceExpand(t, expected);
+    int b = libraryExpand(t, actual);
+    return a == b && memcmp(expected, actual, FRAME_BYTES) == 0;
+}
+
+static bool fillAlignments()
+{
+    uint32_t expected[64], actual[64];
+    for (int offset = 0; offset < 8; offset++)
+    {
+        for (int count = 0; count + offset <= 48; count++)
+        {
+            for (int i = 0; i < 64; i++)
+            {
+                expected[i] = actual[i] = i;
+            }
+            for (int i = 0; i < count; i++)
+            {
+                expected[offset + i] = 0x123456;
+            }
+            fillPixels(actual + offset, 0x123456, count);
+            if (memcmp(expected, actual, sizeof(expected)) != 0)
+            {
+                printf("fillPixels differs at offset %d count %d\n", offset, count);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static double pixelsPerMicrosecond(const RunTable& t, uint32_t* frame, int n, bool library)
+{
+    uint64_t start = nowNanos();
+    uint64_t pixels = 0;
+    for (int i = 0; i < n; i++)
+    {
+        pixels += library ? libraryExpand(t, frame) : referenceExpand(t, frame);
+    }
+    uint64_t elapsed = nowNanos() - start;
+    return elapsed ? pixels * 1000.0 / elapsed : 0;
+}
+
+// the run fills alone, colors already parsed: one store per pixel
+// against fillPixels()
+static double fillPerMicrosecond(const RunTable& t, uint32_t* frame, int n, bool library)
+{
+    std::vector<uint32_t> rgb;
+    for (size_t i = 0; i < t.indices.size(); i++)
+    {
+        rgb.push_back(t.indices[i] >= 0 ? parseColor(t.colors[t.indices[i]]) : 0);
+    }
+    uint64_t start = nowNanos();
+    uint64_t pixels = 0;
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t* p = frame;
+        for (size_t r = 0; r < rgb.size(); r++)
+        {
+            int count = t.counts[r];
+            if (library)
+            {
+                fillPixels(p, rgb[r], count);
+            }
+            else
+            {
+                for (int j = 0; j < count; j++)
+                {
+                    p[j] = rgb[r];
+                }
+            }
+            p += count;
+        }
+        pixels += p - frame;
+    }
+    uint64_t elapsed = nowNanos() - start;
+    return elapsed ? pixels * 1000.0 / elapsed : 0;
+}
+
+int rleCommand(int argc, char** argv)
+{
+    int n = argc > 0 ? atoi(argv[0]) : 200;
+    n = n > 0 ? n : 200;
+    uint32_t* expected = new uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+    uint32_t* actual = new uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+    bool ok = fillAlignments();
+
+    for (int i = 0; i < 50 && ok; i++)
+    {
+        RunTable t;
+        randomTable(t);
+        if (!sameExpansion(t, expected, actual))
+        {
+            printf("random table %d (%d runs) differs from the scalar decoder\n", i, (int)t.indices.size());
+            ok = false;
+        }
+    }
+    if (ok)
+    {
+        printf("fillPixels alignments and 50 random tables match the scalar decoder\n");
+    }
+
+    printf("%-12s %6s %7s | %-22s | %-22s\n", "", "", "", "   decode (px/us)", "   fill only (px/us)");
+    printf("%-12s %6s %7s | %7s %7s %6s | %7s %7s %6s\n", "screen", "runs", "px/run", 
+           "scalar", "library", "gain", "scalar", "vector", "gain");
+    for (int s = 0; s < screenCount; s++)
+    {
+        sim::reset();
+        screens[s].display();
+        RunTable t;
+        tableFromScreen(t, sim::framebuffer());
+        if (!sameExpansion(t, expected, actual))
+        {
+            printf("%s differs from the scalar decoder\n", screens[s].name);
+            ok = false;
+            continue;
+        }
+        double scalar = pixelsPerMicrosecond(t, actual, n, false);
+        double library = pixelsPerMicrosecond(t, actual, n, true);
+        double scalarFill = fillPerMicrosecond(t, actual, n, false);
+        double vectorFill = fillPerMicrosecond(t, actual, n, true);
+        printf("%-12s %6d %7.1f | %7.0f %7.0f %5.1fx | %7.0f %7.0f %5.1fx\n", screens[s].name, 
+               (int)t.indices.size(), (double)SCREEN_WIDTH * SCREEN_HEIGHT / t.indices.size(), 
+               scalar, library, scalar > 0 ? library / scalar : 0, 
+               scalarFill, vectorFill, scalarFill > 0 ? vectorFill / scalarFill : 0);
+    }
+    delete[] expected;
+    delete[] actual;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include "tool.h"
+
+/* ---------- Built-in Screens ---------- */
+
+const BuiltinScreen screens[] =
+{
+    { "home",       displayHome,        printPerformance },
+    { "heading",    displayHeading,     drawHeading },
+    { "ports",      displayPorts,       drawPorts },
+    { "auton",      displayAuton,       nullptr },
+    { "auton_red",  displayAutonRed,    nullptr },
+    { "auton_blue", displayAutonBlue,   nullptr },
+    { "logo",       displayLogo,        nullptr },
+    { "util",       displayUtil,        nullptr },
+};
+const int screenCount = sizeof(screens) / sizeof(screens[0]);
+
+
+/* ---------- Helpers ---------- */
+
+uint64_t nowNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+FILE* openOutput(const char* path)
+{
+    if (!path || strcmp(path, "-") == 0)
+    {
+        return stdout;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file)
+    {
+        fprintf(stderr, "cannot write %s\n", path);
+    }
+    return file;
+}
+int closeOutput(FILE* file)
+{
+    if (file == stdout)
+    {
+        return fflush(file) == 0 ? 0 : 1;
+    }
+    return fclose(file) == 0 ? 0 : 1;
+}
+
+
+/* ---------- render / menu ---------- */
+
+int renderCommand(int argc, char** argv)
+{
+    const char* dir = argc > 0 ? argv[0] : ".";
+    for (int i = 0; i < screenCount; i++)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.ppm", dir, screens[i].name);
+        sim::reset();
+        screens[i].display();
+        if (!sim::savePPM(path))
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            return 1;
+        }
+        printf("%s\n", path);
+    }
+    return 0;
+}
+
+int menuCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: menu <out.ppm> [x,y ...]\n");
+        return 2;
+    }
+    MonitorSetup();
+    for (int i = 1; i < argc; i++)
+    {
+        int x, y;
+        if (sscanf(argv[i], "%d,%d", &x, &y) != 2)
+        {
+            fprintf(stderr, "bad tap '%s', expected x,y\n", argv[i]);
+            return 2;
+        }
+        sim::tap(x, y);
+        MonitorStep();      // reset() picks up the touch
+        MonitorStep();      // the active interface handles it
+    }
+    sim::stopAllTasks();
+    if (!sim::savePPM(argv[0]))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
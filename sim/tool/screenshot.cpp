@@ -0,0 +1,67 @@
+#include "tool.h"
+
+/*  Stands in for a screenshot taken on the robot. The simulator has the
+    real framebuffer, so it is the frame source instead of the tracked
+    frame, and the file lands in the directory given, through the
+    simulated SD card. */
+
+static uint32_t shown[SCREEN_WIDTH * SCREEN_HEIGHT];   // what take() copied
+
+static bool framebufferSource(uint32_t* frame)
+{
+    memcpy(frame, sim::framebuffer(), FRAME_BYTES);     // top SCREEN_HEIGHT rows
+    memcpy(shown, frame, FRAME_BYTES);
+    return true;
+}
+
+int screenshotCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: screenshot <out.wlia> [x,y ...]\n");
+        return 2;
+    }
+    MonitorSetup();
+    for (int i = 1; i < argc; i++)
+    {
+        int x, y;
+        if (sscanf(argv[i], "%d,%d", &x, &y) != 2)
+        {
+            fprintf(stderr, "bad tap '%s', expected x,y\n", argv[i]);
+            return 2;
+        }
+        sim::tap(x, y);
+        MonitorStep();
+        MonitorStep();
+    }
+
+    const char* name = useDirectoryOf(argv[0]);
+    Screenshot::setSource(framebufferSource);
+    uint64_t start = nowNanos();
+    if (!Screenshot::take(name))
+    {
+        fprintf(stderr, "cannot take a screenshot\n");
+        return 1;
+    }
+    uint64_t returned = nowNanos() - start;
+    while (Screenshot::isBusy())
+    {
+        wait(1, msec);
+    }
+    ScreenshotStats stats = Screenshot::getStats();
+    if (stats.written != 1)
+    {
+        fprintf(stderr, "cannot write %s\n", argv[0]);
+        return 1;
+    }
+
+    // read it back the way the Brain would; update tasks may have drawn
+    // since, so compare with the frame take() copied
+    uint32_t* frame = new uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+    bool same = loadAsset(name, frame) && memcmp(frame, shown, FRAME_BYTES) == 0;
+    delete[] frame;
+    printf("%s: take() returned in %.3f ms, saved in %u ms, %u bytes, %s\n", argv[0],
+           returned / 1e6, stats.lastMs, stats.lastBytes, same ? "matches the screen" : "DIFFERS from the screen");
+    sim::stopAllTasks();
+    return same ? 0 : 1;
+}
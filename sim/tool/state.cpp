@@ -0,0 +1,66 @@
+#include "tool.h"
+
+/*  Simulates two boots of the robot against a directory standing in for
+    the SD card: the first run taps through the menu and saves, a second
+    run with the same directory should start where the first one ended.
+    Started anywhere but Home, the menu must have a history to go back
+    through: with none, Back on Perf or Field would do nothing. */
+
+// the routines the built-in auton screens select, as main.cpp registers them
+static const char* const routineNames[] =
+{
+    "Red AWP", "Red 1", "Red 2", "Blue AWP", "Blue 1", "Blue 2"
+};
+static void noRoutine() {}
+
+static void printState(const char* label)
+{
+    printf("%s: screen=\"%s\" routine=\"%s\" sequence=%u\n", label,
+           UIState::getScreen(), UIState::getRoutine(), UIState::getSequence());
+}
+
+int warmstartCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: warmstart <sd dir> [x,y ...]\n");
+        return 2;
+    }
+    sim::setSDRoot(argv[0]);
+    for (const char* name : routineNames)
+    {
+        if (Auton::find(name) < 0)
+        {
+            Auton::add(name, noRoutine);
+        }
+    }
+
+    MonitorSetup();
+    printState(UIState::wasLoaded() ? "loaded" : "no saved state");
+    if (UIState::wasLoaded() && strcmp(UIState::getScreen(), "Home") != 0 && NavHistory::depth() == 0)
+    {
+        fprintf(stderr, "started on %s with no history to go back through\n", UIState::getScreen());
+        return 1;
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        int x, y;
+        if (sscanf(argv[i], "%d,%d", &x, &y) != 2)
+        {
+            fprintf(stderr, "bad tap '%s', expected x,y\n", argv[i]);
+            return 2;
+        }
+        sim::tap(x, y);
+        MonitorStep();
+        MonitorStep();
+    }
+
+    // as if the menu then sat idle for UI_STATE_SAVE_DELAY
+    if (!UIState::save())
+    {
+        fprintf(stderr, "cannot write the state to %s\n", argv[0]);
+        return 1;
+    }
+    printState("saved");
+    return 0;
+}
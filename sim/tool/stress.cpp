@@ -0,0 +1,355 @@
+#include "tool.h"
+
+#include <thread>
+
+/*  Builds a random graph of screens, taps buttons on whichever screen is
+    active as fast as possible and checks after every tap that
+
+      - exactly one screen is active and none is left mid-transition,
+      - the active screen and NavHistory depth match a reference model of
+        the navigation rules (links, Back, unwind to a screen in history),
+      - only the active screen's update task is running.
+
+    Each screen draws a small RLE strip and is cacheable, so snapshot
+    allocation and eviction are exercised too.
+
+    With threads > 0, every activate() pass is run by that many threads at
+    once, each walking the screens from a different start, while the
+    update tasks tick on their own threads: all of them race for each
+    touch and exactly one must handle it. Build with make host-tsan to run
+    this under ThreadSanitizer.  */
+
+#define STRESS_MAX_BUTTONS 12
+
+/* ---------- Random Graph ---------- */
+
+static uint32_t rngState = 1;
+static uint32_t rng()
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct StressScreen
+{
+    Interface itf;
+    std::vector<std::vector<double>> coords;
+    std::vector<Interface*> links;      // shorter than coords: action-only buttons
+    uint32_t color;
+    bool hasUpdate;
+};
+
+static std::vector<StressScreen> graph;
+static std::atomic<uint32_t> actionCount(0);
+static std::atomic<uint32_t> updateCount(0);
+
+static void drawStressScreen(int id)
+{
+    static const char* const palette[] = { "#e6194b", "#3cb44b", "#4363d8", "#f58231", "#911eb4", "#46f0f0" };
+    const int indices[] = { id % 6 };
+    const int counts[] = { SCREEN_WIDTH * 8 };
+    drawImageRLE(palette, indices, counts, 1);
+
+    Brain.Screen.setPenColor(white);
+    Brain.Screen.setFillColor(transparent);
+    for (const std::vector<double>& c : graph[id].coords)
+    {
+        Brain.Screen.drawRectangle(c[0], c[2], c[1] - c[0], c[3] - c[2]);
+    }
+}
+
+static void buildGraph(int screens, int fanout)
+{
+    graph.clear();
+    graph.resize(screens);
+    for (int id = 0; id < screens; id++)
+    {
+        StressScreen& s = graph[id];
+        int buttons = 1 + rng() % fanout;
+        for (int b = 0; b < buttons; b++)
+        {
+            // 4 x 3 grid of 100 x 60 buttons
+            double x = 20 + (b % 4) * 115, y = 20 + (b / 4) * 75;
+            s.coords.push_back({ x, x + 100, y, y + 60 });
+        }
+        // the last button is sometimes action-only
+        int linked = buttons - (buttons > 1 && rng() % 4 == 0 ? 1 : 0);
+        for (int b = 0; b < linked; b++)
+        {
+            uint32_t r = b == 0 ? 2 : rng() % 10;     // button 0 always leaves
+            int other = (id + 1 + rng() % (screens - 1)) % screens;
+            s.links.push_back(r == 0 ? &Interface::Back
+                            : r == 1 ? &graph[id].itf
+                            : &graph[other].itf);
+        }
+        s.hasUpdate = rng() % 3 == 0;
+    }
+    for (int id = 0; id < screens; id++)
+    {
+        StressScreen& s = graph[id];
+        ActionCallback action = [](int) { actionCount.fetch_add(1); };
+        DisplayCallback display = [id]() { drawStressScreen(id); };
+        if (s.hasUpdate)
+        {
+            UpdateCallback update = []() { updateCount.fetch_add(1); return 0; };
+            s.itf = Interface(&s.coords, &s.links, action, display, update);
+        }
+        else
+        {
+            s.itf = Interface(&s.coords, &s.links, action, display);
+        }
+        s.itf.setCacheable(true);
+    }
+}
+
+
+/* ---------- Reference Model ---------- */
+
+static std::vector<int> modelStack;     // mirrors NavHistory, newest last
+static int modelActive = 0;
+
+static int indexOf(const Interface* itf)
+{
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+        if (&graph[i].itf == itf)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void modelTap(int button)
+{
+    StressScreen& s = graph[modelActive];
+    if (button < 0 || button >= (int)s.links.size())
+    {
+        return;                 // miss or action-only: stay
+    }
+    Interface* target = s.links[button];
+    if (target == &Interface::Back)
+    {
+        if (!modelStack.empty())
+        {
+            modelActive = modelStack.back();
+            modelStack.pop_back();
+        }
+        return;
+    }
+    int id = indexOf(target);
+    if (id == modelActive)
+    {
+        return;
+    }
+    for (int i = (int)modelStack.size() - 1; i >= 0; i--)
+    {
+        if (modelStack[i] == id)
+        {
+            modelStack.resize(i);
+            modelActive = id;
+            return;
+        }
+    }
+    if ((int)modelStack.size() == NAV_HISTORY_DEPTH)
+    {
+        modelStack.erase(modelStack.begin());
+    }
+    modelStack.push_back(modelActive);
+    modelActive = id;
+}
+
+
+/* ---------- Invariants ---------- */
+
+static bool checkInvariants(int tap)
+{
+    int active = -1, others = 0;
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+        int index = graph[i].itf.getIndex();
+        if (index == ITF_ACTIVE && active < 0)
+        {
+            active = (int)i;
+        }
+        else if (index != ITF_INACTIVE)
+        {
+            others++;
+            fprintf(stderr, "tap %d: screen %d left in state %d\n", tap, (int)i, index);
+        }
+    }
+    bool ok = others == 0;
+    if (active != modelActive)
+    {
+        fprintf(stderr, "tap %d: screen %d active, model expects %d\n", tap, active, modelActive);
+        ok = false;
+    }
+    if (NavHistory::depth() != (int)modelStack.size())
+    {
+        fprintf(stderr, "tap %d: history depth %d, model expects %d\n",
+                tap, NavHistory::depth(), (int)modelStack.size());
+        ok = false;
+    }
+    int tasks = sim::liveTasks();
+    int expected = active >= 0 && graph[active].hasUpdate ? 1 : 0;
+    if (tasks != expected)
+    {
+        fprintf(stderr, "tap %d: %d update tasks running, expected %d\n", tap, tasks, expected);
+        ok = false;
+    }
+    return ok;
+}
+
+
+/* ---------- stress ---------- */
+
+static void step()
+{
+    for (StressScreen& s : graph)
+    {
+        s.itf.activate();
+    }
+    Interface::reset();
+}
+
+/* ---------- Threaded Passes ---------- */
+
+static std::atomic<uint32_t> passRound(0);
+static std::atomic<uint32_t> passesDone(0);
+static std::atomic<bool> workersQuit(false);
+
+static void activateWorker(int id)
+{
+    uint32_t seen = 0;
+    while (!workersQuit.load())
+    {
+        uint32_t round = passRound.load();
+        if (round == seen)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        seen = round;
+        size_t first = (id * 7 + round) % graph.size();
+        for (size_t i = 0; i < graph.size(); i++)
+        {
+            graph[(first + i) % graph.size()].itf.activate();
+        }
+        passesDone.fetch_add(1);
+    }
+}
+
+// reset() picks up the touch, then every worker runs one activate() pass
+static void threadedStep(int threads)
+{
+    Interface::reset();
+    uint32_t round = passRound.fetch_add(1) + 1;
+    while (passesDone.load() < round * (uint32_t)threads)
+    {
+        std::this_thread::yield();
+    }
+}
+
+int stressCommand(int argc, char** argv)
+{
+    int taps = argc > 0 ? atoi(argv[0]) : 10000;
+    int screens = argc > 1 ? atoi(argv[1]) : 50;
+    int fanout = argc > 2 ? atoi(argv[2]) : 6;
+    rngState = argc > 3 ? (uint32_t)strtoul(argv[3], nullptr, 0) : 1;
+    int threads = argc > 4 ? atoi(argv[4]) : 0;
+    threads = threads < 0 ? 0 : threads > 16 ? 16 : threads;
+    screens = screens > 1 ? screens : 2;
+    fanout = fanout < 1 ? 1 : fanout > STRESS_MAX_BUTTONS ? STRESS_MAX_BUTTONS : fanout;
+    rngState = rngState ? rngState : 1;
+
+    sim::reset();
+    NavHistory::clear();
+    buildGraph(screens, fanout);
+    modelStack.clear();
+    modelActive = 0;
+    graph[0].itf.setIndex(ITF_ACTIVE);
+    graph[0].itf.Display();
+    step();                     // settle: consumes the initial touch claim
+
+    std::vector<std::thread> workers;
+    passRound.store(0);
+    passesDone.store(0);
+    workersQuit.store(false);
+    for (int i = 0; i < threads; i++)
+    {
+        workers.push_back(std::thread(activateWorker, i));
+    }
+
+    Histogram latency;
+    uint32_t navigations = 0, worstTap = 0;
+    uint64_t start = nowNanos();
+    for (int t = 0; t < taps; t++)
+    {
+        StressScreen& s = graph[modelActive];
+        int button = -1, x = 470, y = 230;      // a miss, ~1 in 10
+        if (rng() % 10)
+        {
+            button = rng() % s.coords.size();
+            x = (int)(s.coords[button][0] + s.coords[button][1]) / 2;
+            y = (int)(s.coords[button][2] + s.coords[button][3]) / 2;
+        }
+        int before = modelActive;
+        modelTap(button);
+        navigations += modelActive != before ? 1 : 0;
+
+        uint64_t tapStart = nowNanos();
+        sim::tap(x, y);
+        if (threads > 0)
+        {
+            threadedStep(threads);
+        }
+        else
+        {
+            step();             // reset() picks up the touch
+            step();             // the active screen handles it
+        }
+        uint32_t elapsed = (uint32_t)((nowNanos() - tapStart) / 1000);
+        latency.record(elapsed);
+        worstTap = elapsed == latency.max() ? t : worstTap;
+
+        if (!checkInvariants(t))
+        {
+            fprintf(stderr, "FAIL after %d taps (seed %s)\n", t + 1, argc > 3 ? argv[3] : "1");
+            workersQuit.store(true);
+            for (std::thread& w : workers)
+            {
+                w.join();
+            }
+            sim::stopAllTasks();
+            return 1;
+        }
+    }
+    double seconds = (nowNanos() - start) / 1e9;
+    workersQuit.store(true);
+    for (std::thread& w : workers)
+    {
+        w.join();
+    }
+
+    for (StressScreen& s : graph)
+    {
+        s.itf.setIndex(ITF_INACTIVE);
+        s.itf.stopUpdateTask();
+    }
+    NavHistory::clear();
+
+    printf("stress: %d taps over %d screens (fanout %d), all invariants held\n", taps, screens, fanout);
+    if (threads > 0)
+    {
+        printf("  activate() run by %d threads at once\n", threads);
+    }
+    printf("  %u navigations, %u actions, %u update passes\n",
+           navigations, actionCount.load(), updateCount.load());
+    printf("  %.0f taps/s, %.0f navigations/s\n", taps / seconds, navigations / seconds);
+    printf("  tap latency us: p50=%u p95=%u p99=%u max=%u (tap %u)\n",
+           latency.percentile(50), latency.percentile(95), latency.percentile(99),
+           latency.max(), worstTap);
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "tool.h"
+
+#include <thread>
+
+/*  Converts a Telemetry log copied off the SD card into CSV, one row per
+    record with the value in real units. The log has no record count, so
+    everything up to the end of the file is read; a partial last record
+    (the Brain reset mid-write) is reported and skipped. */
+
+static const char* typeName(uint8_t type)
+{
+    switch (type)
+    {
+        case TELEMETRY_MOTOR_TEMP: return "motor_temp";
+        case TELEMETRY_MOTOR_VOLT: return "motor_volt";
+        case TELEMETRY_HEADING:    return "heading";
+        default:                   return type >= TELEMETRY_USER ? "user" : "unknown";
+    }
+}
+
+static double scaled(const TelemetryRecord& record)
+{
+    switch (record.type)
+    {
+        case TELEMETRY_MOTOR_TEMP: return record.value / 10.0;      // C
+        case TELEMETRY_MOTOR_VOLT: return record.value / 1000.0;    // V
+        case TELEMETRY_HEADING:    return record.value / 10.0;      // degrees
+        default:                   return record.value;
+    }
+}
+
+int telemetry2csvCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: telemetry2csv <log> [out.csv]\n");
+        return 2;
+    }
+    FILE* file = fopen(argv[0], "rb");
+    if (!file)
+    {
+        fprintf(stderr, "cannot read %s\n", argv[0]);
+        return 1;
+    }
+    TelemetryHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != TELEMETRY_MAGIC ||
+        header.version != TELEMETRY_VERSION || header.recordSize != sizeof(TelemetryRecord))
+    {
+        fprintf(stderr, "%s is not a version %d telemetry log\n", argv[0], TELEMETRY_VERSION);
+        fclose(file);
+        return 1;
+    }
+    FILE* out = openOutput(argc > 1 ? argv[1] : nullptr);
+    if (!out)
+    {
+        fclose(file);
+        return 1;
+    }
+
+    // time in ms since start; port as printed on the Brain (PORT1 = 1)
+    fprintf(out, "time_ms,type,port,value\n");
+    TelemetryRecord records[256];
+    size_t total = 0, n;
+    uint32_t last = 0;
+    int backwards = 0;
+    while ((n = fread(records, sizeof(TelemetryRecord), 256, file)) > 0)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const TelemetryRecord& r = records[i];
+            if (r.type >= TELEMETRY_USER)
+            {
+                fprintf(out, "%u,user%u,%u,%d\n", r.time, r.type - TELEMETRY_USER, r.port, r.value);
+            }
+            else
+            {
+                fprintf(out, "%u,%s,%u,%g\n", r.time, typeName(r.type), r.port + 1, scaled(r));
+            }
+            backwards += r.time < last;
+            last = r.time;
+        }
+        total += n;
+    }
+    long end = ftell(file);
+    fclose(file);
+
+    long extra = end - (long)sizeof(header) - (long)(total * sizeof(TelemetryRecord));
+    fprintf(stderr, "%s: %zu records, %.1f s", argv[0], total, last / 1000.0);
+    if (extra > 0)
+    {
+        fprintf(stderr, ", %ld trailing bytes skipped", extra);
+    }
+    if (backwards)
+    {
+        fprintf(stderr, ", %d out of order", backwards);
+    }
+    fprintf(stderr, "\n");
+    return closeOutput(out);
+}
+
+/*  Logs more records than the ring holds, from several threads at once,
+    with the flusher running, then converts the log with telemetry2csv and
+    reads the CSV back. Every record must be accounted for: accepted or
+    dropped as log() reported, every accepted one written to the SD card
+    once, and each thread's values in the order it logged them. */
+
+#define RING_CHECK_THREADS_MAX 8
+#define RING_CHECK_BURST 256            // records logged between pauses
+
+// bursts with short pauses, so the flusher drains the ring in between
+static void logRecords(int thread, int count, std::vector<bool>* accepted)
+{
+    for (int i = 0; i < count; i++)
+    {
+        (*accepted)[i] = Telemetry::log(TELEMETRY_USER, (uint8_t)thread, (int16_t)i);
+        if (i % RING_CHECK_BURST == RING_CHECK_BURST - 1)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+int telemetryCommand(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "usage: telemetry <sd dir> [records] [threads]\n");
+        return 2;
+    }
+    int records = argc > 1 ? atoi(argv[1]) : 16 * TELEMETRY_RING_RECORDS;
+    int threads = argc > 2 ? atoi(argv[2]) : RING_CHECK_THREADS_MAX;
+    threads = threads < 1 ? 1 : threads > RING_CHECK_THREADS_MAX ? RING_CHECK_THREADS_MAX : threads;
+    int each = (records > 0 ? records : 16 * TELEMETRY_RING_RECORDS) / threads;
+    each = each < 32767 ? each : 32767;     // values are int16_t
+    records = each * threads;
+    sim::setSDRoot(argv[0]);
+
+    if (!Telemetry::start("ring.wlit"))
+    {
+        fprintf(stderr, "telemetry: cannot create ring.wlit in %s\n", argv[0]);
+        return 1;
+    }
+    std::vector<bool> accepted[RING_CHECK_THREADS_MAX];
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; t++)
+    {
+        accepted[t].assign(each, false);
+        producers.push_back(std::thread(logRecords, t, each, &accepted[t]));
+    }
+    for (std::thread& p : producers)
+    {
+        p.join();
+    }
+    Telemetry::stop();
+    TelemetryStats stats = Telemetry::getStats();
+
+    uint32_t taken = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        for (int i = 0; i < each; i++)
+        {
+            taken += accepted[t][i];
+        }
+    }
+    bool ok = true;
+    if (stats.logged + stats.dropped != (uint32_t)records || stats.logged != taken)
+    {
+        printf("%d records logged: %u accepted and %u dropped, log() accepted %u\n", records,
+               stats.logged, stats.dropped, taken);
+        ok = false;
+    }
+    if (stats.written != stats.logged || stats.lost != 0)
+    {
+        printf("%u records accepted, %u written, %u lost\n", stats.logged, stats.written, stats.lost);
+        ok = false;
+    }
+
+    // decode with telemetry2csv and read the CSV back
+    char log[512], csv[512];
+    snprintf(log, sizeof(log), "%s/ring.wlit", sim::sdRoot());
+    snprintf(csv, sizeof(csv), "%s/ring.csv", sim::sdRoot());
+    char* convert[] = { log, csv };
+    if (telemetry2csvCommand(2, convert) != 0)
+    {
+        return 1;
+    }
+    FILE* file = fopen(csv, "r");
+    if (!file)
+    {
+        fprintf(stderr, "cannot read %s\n", csv);
+        return 1;
+    }
+    int next[RING_CHECK_THREADS_MAX] = {};     // value each thread's next row must exceed
+    for (int t = 0; t < threads; t++)
+    {
+        next[t] = -1;
+    }
+    std::vector<bool> seen[RING_CHECK_THREADS_MAX];
+    for (int t = 0; t < threads; t++)
+    {
+        seen[t].assign(each, false);
+    }
+    uint32_t rows = 0;
+    int bad = 0;
+    char line[128];
+    fgets(line, sizeof(line), file);        // heading
+    while (fgets(line, sizeof(line), file))
+    {
+        unsigned time, user, port;
+        int value;
+        rows++;
+        if (sscanf(line, "%u,user%u,%u,%d", &time, &user, &port, &value) != 4 || user != 0 ||
+            port >= (unsigned)threads || value < 0 || value >= each || !accepted[port][value] ||
+            seen[port][value] || value <= next[port])
+        {
+            if (bad++ < 5)
+            {
+                printf("unexpected row %u: %s", rows, line);
+            }
+            continue;
+        }
+        seen[port][value] = true;
+        next[port] = value;
+    }
+    fclose(file);
+    if (rows != stats.written || bad)
+    {
+        printf("%u CSV rows for %u records written, %d unexpected\n", rows, stats.written, bad);
+        ok = false;
+    }
+
+    printf("%d records from %d threads through a %d-record ring: %u written in %u blocks, "
+           "%u dropped\n", records, threads, TELEMETRY_RING_RECORDS, stats.written, stats.blocks,
+           stats.dropped);
+    printf("telemetry %s\n", ok ? "accounted for" : "FAILED");
+    return ok ? 0 : 1;
+}
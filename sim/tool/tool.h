@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       tool.h                                                    */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Shared declarations for the wlic-host commands            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "vex.h"
+#include "sim.h"
+
+/*-----------------------------------------------------------------------------
+ * BUILT-IN SCREENS
+ *---------------------------------------------------------------------------*/
+
+struct BuiltinScreen
+{
+    const char* name;
+    void (*display)();
+    int (*update)();        // one pass of the screen's update task, or null
+};
+
+extern const BuiltinScreen screens[];
+extern const int screenCount;
+
+/*-----------------------------------------------------------------------------
+ * HELPERS
+ *---------------------------------------------------------------------------*/
+
+/**
+ * @brief Monotonic host time in nanoseconds
+ */
+uint64_t nowNanos();
+
+/**
+ * @brief Open an output file, "-" or null meaning stdout
+ * @return FILE* or nullptr (with a message on stderr) on failure
+ */
+FILE* openOutput(const char* path);
+
+/**
+ * @brief Close a file from openOutput()
+ * @return 0 on success, 1 if the write failed
+ */
+int closeOutput(FILE* file);
+
+/**
+ * @brief Point the simulated SD card at the directory of a file
+ * @return The file name within that directory ("dir/name" gives "name")
+ */
+const char* useDirectoryOf(const char* path);
+
+/*-----------------------------------------------------------------------------
+ * COMMANDS
+ *---------------------------------------------------------------------------*/
+
+// each takes the arguments after the command name and returns the exit code
+int renderCommand(int argc, char** argv);
+int menuCommand(int argc, char** argv);
+int benchCommand(int argc, char** argv);
+int goldenCommand(int argc, char** argv);
+int checkCommand(int argc, char** argv);
+int replayCommand(int argc, char** argv);
+int recordCommand(int argc, char** argv);
+int stressCommand(int argc, char** argv);
+int packCommand(int argc, char** argv);
+int unpackCommand(int argc, char** argv);
+int warmstartCommand(int argc, char** argv);
+int telemetry2csvCommand(int argc, char** argv);
+int telemetryCommand(int argc, char** argv);
+int screenshotCommand(int argc, char** argv);
+int fieldmapCommand(int argc, char** argv);
+int idleCommand(int argc, char** argv);
+int glyphsCommand(int argc, char** argv);
+int rleCommand(int argc, char** argv);
+int heapCommand(int argc, char** argv);
+int callbackCommand(int argc, char** argv);
+int mirrorCommand(int argc, char** argv);
+int portsCommand(int argc, char** argv);
+int healthCommand(int argc, char** argv);
@@ -0,0 +1,126 @@
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*    Module:       wlic-host.cpp                                             */
+/*    Author:       Win Yeh                                                   */
+/*    Created:      2025                                                      */
+/*    Description:  Headless host driver for the WLIC menu system             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*  Build with `make host`, then run build/host/wlic-host <command>:
+
+      render [dir]              render every built-in screen to dir/<name>.ppm
+      menu <out.ppm> [x,y ...]  run the built-in menu, tap each point in turn
+                                and save the final screen
+      bench [out.csv] [n]       time n draws of every screen and update
+                                function, with draw counts, as CSV
+      golden [file]             record hashes of every built-in screen
+      check [file] [diffdir]    compare against the recorded hashes, writing
+                                <name>.diff.ppm for each mismatch
+      replay <log> [out.ppm]    replay an InputRecorder log into the menu
+                                and report touch latency and draw times
+      record <sddir> [x,y ...]  record a tapped session, save it to sddir and
+                                replay it, checking it reaches the same screens
+      stress [taps] [screens] [fanout] [seed] [threads]
+                                tap randomly through a synthetic screen graph,
+                                checking navigation invariants after each tap;
+                                threads > 0 runs activate() from that many
+                                threads at once
+      pack <screen|in.ppm> <out.wlia> [#rrggbb]
+                                encode a built-in screen or a PPM image as an
+                                SD card asset, optionally with a transparent color
+      unpack <in.wlia> <out.ppm>
+                                stream an asset onto the screen and save it
+      warmstart <sddir> [x,y ...]
+                                boot the menu with saved state from sddir, tap,
+                                and save the state for the next boot
+      telemetry2csv <log> [out.csv]
+                                convert a Telemetry log to CSV
+      telemetry <sddir> [n] [threads]
+                                log n records from several threads through
+                                the ring and check each one reaches the CSV
+      screenshot <out.wlia> [x,y ...]
+                                run the menu, tap each point and save the screen
+                                with the background Screenshot encoder
+      fieldmap <out.ppm> [seconds]
+                                drive a figure eight past the field map and
+                                report what each update draws
+      idle [timeout ms] [s]     run the menu in real time until it goes idle,
+                                stay idle s seconds, then tap to wake it
+      glyphs [out.ppm] [n]      time n updates of a numeric readout with
+                                printAt and with GlyphText, and save a sample
+      rle [n]                   check the RLE run expander against a scalar
+                                decoder and time both on every screen
+      heap [n]                  navigate the built-in menu n times and check
+                                that the live heap stays flat
+      callback [n]              check that Callback construct, copy, assign
+                                and invoke never allocate
+      mirror                    step ControllerMirror through row changes and
+                                check the writes and cells each one costs
+      ports                     plug and unplug devices and check that the port
+                                map redraws only the cells that changed
+      health                    ramp motor temperatures and check the health
+                                levels and listener calls */
+
+#include "tool.h"
+
+/*-----------------------------------------------------------------------------
+ * MAIN
+ *---------------------------------------------------------------------------*/
+
+struct Command
+{
+    const char* name;
+    int (*run)(int argc, char** argv);
+    const char* usage;
+};
+
+static const Command commands[] =
+{
+    { "render", renderCommand,  "render [dir]" },
+    { "menu",   menuCommand,    "menu <out.ppm> [x,y ...]" },
+    { "bench",  benchCommand,   "bench [out.csv] [iterations]" },
+    { "golden", goldenCommand,  "golden [file]" },
+    { "check",  checkCommand,   "check [golden file] [diff dir]" },
+    { "replay", replayCommand,  "replay <log> [out.ppm]" },
+    { "record", recordCommand,  "record <sd dir> [x,y ...]" },
+    { "stress", stressCommand,  "stress [taps] [screens] [fanout] [seed] [threads]" },
+    { "pack",   packCommand,    "pack <screen|in.ppm> <out.wlia> [#rrggbb transparent]" },
+    { "unpack", unpackCommand,  "unpack <in.wlia> <out.ppm>" },
+    { "warmstart", warmstartCommand, "warmstart <sd dir> [x,y ...]" },
+    { "telemetry2csv", telemetry2csvCommand, "telemetry2csv <log> [out.csv]" },
+    { "telemetry", telemetryCommand, "telemetry <sd dir> [records] [threads]" },
+    { "screenshot", screenshotCommand, "screenshot <out.wlia> [x,y ...]" },
+    { "fieldmap", fieldmapCommand, "fieldmap <out.ppm> [seconds]" },
+    { "idle",   idleCommand,    "idle [timeout ms] [idle seconds]" },
+    { "glyphs", glyphsCommand,  "glyphs [out.ppm] [updates]" },
+    { "rle",    rleCommand,     "rle [iterations]" },
+    { "heap",   heapCommand,    "heap [navigations]" },
+    { "callback", callbackCommand, "callback [rounds]" },
+    { "mirror", mirrorCommand,  "mirror" },
+    { "ports",  portsCommand,   "ports" },
+    { "health", healthCommand,  "health" },
+};
+
+int main(int argc, char** argv)
+{
+    sim::setTimeScale(0);
+    if (argc >= 2)
+    {
+        for (const Command& command : commands)
+        {
+            if (strcmp(argv[1], command.name) == 0)
+            {
+                int result = command.run(argc - 2, argv + 2);
+                sim::stopAllTasks();
+                return result;
+            }
+        }
+    }
+    fprintf(stderr, "usage: %s <command>\n", argv[0]);
+    for (const Command& command : commands)
+    {
+        fprintf(stderr, "  %s\n", command.usage);
+    }
+    return 2;
+}
@@ -1,7 +1,15 @@
 #include "vex.h"
 
-int brain_x, brain_y = -1; 
-int Interface::isActive = 0;
+int brain_x = -1, brain_y = -1; 
+std::atomic<int> Interface::isActive(1);    // nothing to claim until reset() sees a touch
+Interface Interface::Back;
+RenderBuffer* Interface::renderBuffer = nullptr;
+RenderStats Interface::renderStats = {};
+
+NavHistory::Entry NavHistory::stack[NAV_HISTORY_DEPTH];
+int NavHistory::count = 0;
+uint32_t NavHistory::snapshotBytes = 0;
+uint32_t NavHistory::snapshotBudget = NAV_SNAPSHOT_BUDGET;
 
 /* ---------- Interface Class ---------- */
 
@@ -10,9 +18,8 @@ Interface::Interface ()
 : button_coord(nullptr), linked_Interface(nullptr), actions(nullptr), display(nullptr), updateInterface(nullptr)
 {
     this->index = -2; 
-    this->isActive = 0;
 }
-Interface::Interface (void (*display)())
+Interface::Interface (DisplayCallback display)
     : button_coord(nullptr), 
       linked_Interface(nullptr), 
       actions(nullptr),
@@ -20,23 +27,21 @@ Interface::Interface (void (*display)())
       updateInterface(nullptr)
 {
     this->index = -2; 
-    this->isActive = 0; 
 }
-Interface::Interface (void (*display)(), int (*updateInterface)())
+Interface::Interface (DisplayCallback display, UpdateCallback updateInterface)
     : button_coord(nullptr), 
       linked_Interface(nullptr), 
       actions(nullptr), display(display), 
       updateInterface(updateInterface)
 {
     this->index = -2; 
-    this->isActive = 0; 
 }
 
 
 // ------ + button only ------
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
-                      void (*actions)(int i),  
-                      void (*display)())
+                      ActionCallback actions,  
+                      DisplayCallback display)
     : button_coord(button_coord), 
       linked_Interface(nullptr), 
       actions(actions), 
@@ -44,125 +49,310 @@ Interface::Interface (std::vector<std::vector<double>>* button_coord,
       updateInterface(nullptr)
 {
     this->index = -2; 
-    this->isActive = 0; 
 }
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
-                      void (*actions)(int i),  
-                      void (*display)(), 
-                      int (*updateInterface)())
+                      ActionCallback actions,  
+                      DisplayCallback display, 
+                      UpdateCallback updateInterface)
     : button_coord(button_coord), 
       linked_Interface(nullptr),
       actions(actions), display(display), 
       updateInterface(updateInterface)
 {
     this->index = -2; 
-    this->isActive = 0; 
 }
 
 
 // ------ + linked_interface ------
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
                       std::vector<Interface*>* linked_Interface, 
-                      void (*display)())
+                      DisplayCallback display)
     : button_coord(button_coord), 
       linked_Interface(linked_Interface), 
       actions(nullptr), display(display), 
       updateInterface(nullptr)
 {
     this->index = -2; 
-    this->isActive = 0; 
 } 
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
                       std::vector<Interface*>* linked_Interface,
-                      void (*actions)(int i),  
-                      void (*display)())
+                      ActionCallback actions,  
+                      DisplayCallback display)
     : button_coord(button_coord), 
       linked_Interface(linked_Interface), 
       actions(actions), display(display), 
       updateInterface(nullptr)
 {
     this->index = -2; 
-    this->isActive = 0; 
 }
 
 
 // ------ + update interface ------
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
                       std::vector<Interface*>* linked_Interface, 
-                      void (*display)(),
-                      int (*updateInterface)())
+                      DisplayCallback display,
+                      UpdateCallback updateInterface)
     : button_coord(button_coord), 
       linked_Interface(linked_Interface), 
       actions(nullptr), display(display), 
       updateInterface(updateInterface)
 {
     this->index = -2; 
-    this->isActive = 0; 
 } 
 Interface::Interface (std::vector<std::vector<double>>* button_coord, 
                       std::vector<Interface*>* linked_Interface,
-                      void (*actions)(int i),  
-                      void (*display)(), 
-                      int (*updateInterface)())
+                      ActionCallback actions,  
+                      DisplayCallback display, 
+                      UpdateCallback updateInterface)
     : button_coord(button_coord), 
       linked_Interface(linked_Interface), 
       actions(actions), display(display), 
       updateInterface(updateInterface)
 {
     this->index = -2; 
-    this->isActive = 0; 
+}
+
+
+// ------ copy ------
+Interface::Interface (const Interface& other)
+    : index(other.index.load()), 
+      button_coord(other.button_coord), 
+      linked_Interface(other.linked_Interface), 
+      actions(other.actions), display(other.display), 
+      updateInterface(other.updateInterface), 
+      updateItf_Task(nullptr), 
+      frame(nullptr), 
+      cacheable(other.cacheable), 
+      name(other.name), 
+      mirror(other.mirror), 
+      buffered(other.buffered), 
+      budget(other.budget), 
+      budgetPolicy(other.budgetPolicy)
+{
+}
+Interface& Interface::operator= (const Interface& other)
+{
+    if (this == &other)
+    {
+        return *this; 
+    }
+    this->stopUpdateTask();     // the task runs this object's old callbacks
+    NavHistory::freeSnapshot(this->frame); 
+    this->frame = nullptr; 
+    this->index = other.index.load(); 
+    this->button_coord = other.button_coord; 
+    this->linked_Interface = other.linked_Interface; 
+    this->actions = other.actions; 
+    this->display = other.display; 
+    this->updateInterface = other.updateInterface; 
+    this->cacheable = other.cacheable; 
+    this->name = other.name; 
+    this->mirror = other.mirror; 
+    this->buffered = other.buffered; 
+    this->budget = other.budget; 
+    this->budgetPolicy = other.budgetPolicy; 
+    return *this; 
+}
+Interface::~Interface ()
+{
+    this->stopUpdateTask();     // the task calls UpdateInterface() on this
+    NavHistory::freeSnapshot(this->frame); 
 }
 
 
 // ------ Functions ------
 int Interface::getIndex()
 {
-    return this->index; 
+    return this->index.load(); 
 }
 void Interface::setIndex(int i)
 {
     this->index = i; 
 }
+bool Interface::transition(int from, int to)
+{
+    return this->index.compare_exchange_strong(from, to); 
+}
+void Interface::setCacheable(bool enable)
+{
+    this->cacheable = enable; 
+}
+void Interface::setName(const char* name)
+{
+    this->name = name; 
+}
+const char* Interface::getName()
+{
+    return this->name; 
+}
+void Interface::setBuffered(bool enable)
+{
+    this->buffered = enable; 
+}
+void Interface::setMirror(DisplayCallback mirror)
+{
+    this->mirror = mirror; 
+}
+void Interface::setBudget(uint32_t us, BudgetPolicy policy)
+{
+    this->budget = us; 
+    this->budgetPolicy = policy; 
+}
+uint32_t Interface::getBudget()
+{
+    return this->budget; 
+}
+int Interface::getBackoff()
+{
+    return this->updateBackoff; 
+}
+RenderBuffer* Interface::getRenderBuffer()
+{
+    if (!renderBuffer)
+    {
+        HeapScope scope(HEAP_RENDER); 
+        renderBuffer = new (std::nothrow) RenderBuffer(); 
+    }
+    return renderBuffer; 
+}
+RenderStats Interface::getRenderStats()
+{
+    return renderStats; 
+}
 
 int Interface::InterfaceChooser()
 {
-    for (int j = 0; j < button_coord->size(); j++)
+    if (!button_coord)
+    {
+        return this->index.load(); 
+    }
+    for (int j = 0; j < (int)button_coord->size(); j++)
     {
         if (brain_x >= (*button_coord)[j][0] && brain_x <= (*button_coord)[j][1] &&
             brain_y >= (*button_coord)[j][2] && brain_y <= (*button_coord)[j][3])
         {
-            this->index = j; 
+            this->transition(ITF_ACTIVE, j); 
             break; 
         }
     }
-    return this->index;  
+    return this->index.load();  
 }
 
 void Interface::Display()
 {
     if (this->display)
     {
-        this->display(); 
+        if (this->cacheable && !this->frame)
+        {
+            this->frame = NavHistory::allocSnapshot(); 
+        }
+        uint32_t start = Perf::begin(); 
+        uint32_t check = Watchdog::begin(); 
+        beginCapture(this->frame); 
+        RenderBuffer* buffer = this->buffered ? getRenderBuffer() : nullptr; 
+        if (buffer)
+        {
+            buffer->begin(); 
+            this->display(); 
+            renderStats = buffer->end(); 
+        }
+        else
+        {
+            this->display(); 
+        }
+        endCapture(); 
+        Perf::endDraw(this, this->name, start); 
+        Watchdog::end(this, this->name, CALLBACK_DISPLAY, check, this->budget); 
+    }
+    this->showMirror(); 
+    this->startUpdateTask(); 
+}
+void Interface::Restore(uint32_t* snapshot)
+{
+    if (this->frame && this->frame != snapshot)
+    {
+        NavHistory::freeSnapshot(this->frame); 
     }
+    this->frame = snapshot; 
+    uint32_t start = Perf::begin(); 
+    drawFrame(snapshot); 
+    Perf::endDraw(this, this->name, start); 
+    this->showMirror(); 
+    this->startUpdateTask(); 
+}
+void Interface::startUpdateTask()
+{
     if (this->updateInterface && !updateItf_Task)
     {
+        HeapScope scope(HEAP_TASKS); 
         updateItf_Task = new task (Interface::launchUpdateItf, this);
     }
 }
 
+void Interface::showMirror()
+{
+    if (!ControllerMirror::isRunning())
+    {
+        return; 
+    }
+    if (this->mirror)
+    {
+        this->mirror(); 
+    }
+    else
+    {
+        ControllerMirror::setLine(0, this->name); 
+        ControllerMirror::setLine(1, ""); 
+        ControllerMirror::setLine(2, ""); 
+    }
+}
+
 int Interface::UpdateInterface()
 {
+    uint32_t check = Watchdog::begin(); 
     this->updateInterface(); 
-    while (this->index == -1 && updateItf_Task)
+    Watchdog::end(this, this->name, CALLBACK_UPDATE, check, this->budget); 
+
+    int strikes = 0;    // update overruns in a row
+    int skip = 0;       // passes left to skip while throttled
+    this->updateBackoff = 1; 
+    while (this->index.load() >= ITF_ACTIVE)
     {
-        if (this->updateInterface)
+        if (this->updateInterface && skip > 0)
         {
+            skip--; 
+        }
+        else if (this->updateInterface)
+        {
+            uint32_t start = Perf::begin(); 
+            check = Watchdog::begin(); 
             this->updateInterface(); 
+            Perf::endUpdate(this, this->name, start); 
+            bool overran = Watchdog::end(this, this->name, CALLBACK_UPDATE, check, this->budget); 
+            if (this->mirror && ControllerMirror::isRunning())
+            {
+                this->mirror(); 
+            }
+
+            strikes = overran ? strikes + 1 : 0; 
+            if (this->budgetPolicy == BUDGET_THROTTLE)
+            {
+                // back off on repeated overruns, recover one step per good pass
+                if (strikes >= WATCHDOG_STRIKES && this->updateBackoff < WATCHDOG_MAX_BACKOFF)
+                {
+                    this->updateBackoff *= 2; 
+                    strikes = 0; 
+                }
+                else if (!overran && this->updateBackoff > 1)
+                {
+                    this->updateBackoff /= 2; 
+                }
+                skip = this->updateBackoff - 1; 
+            }
         }
-        wait(100, msec); 
+        IdlePolicy::pause(100);     // IDLE_PERIOD_MS while nothing changes
     }
     
-    printf("in \n\n"); 
     return 0; 
 }
 int Interface::launchUpdateItf(void* obj)
@@ -187,31 +377,97 @@ void Interface::stopUpdateTask()
 
 void Interface::Action()
 {
-    if (this->actions)
+    this->Action(this->index.load()); 
+}
+void Interface::Action(int button)
+{
+    if (this->actions && button >= 0)
     {
-        actions(this->index); 
+        uint32_t check = Watchdog::begin(); 
+        actions(button); 
+        Watchdog::end(this, this->name, CALLBACK_ACTION, check, this->budget); 
+        if (this->mirror)
+        {
+            this->showMirror();     // e.g. a newly selected routine
+        }
     }
 }
 void Interface::activate()
 { 
-    if (this->index == -1)
+    if (this->index.load() != ITF_ACTIVE)
     {
-        
-        if (Interface::isActive == 0)
+        return; 
+    }
+
+    // claim this touch; only the first active interface in a loop gets it
+    int idle = 0; 
+    if (!Interface::isActive.compare_exchange_strong(idle, 1))
+    {
+        return; 
+    }
+
+    int button = this->InterfaceChooser();    // ACTIVE -> PRESSED(button)
+    if (button < 0)
+    {
+        return; 
+    }
+
+    Interface* chosen = nullptr; 
+    if (this->linked_Interface && (size_t)button < this->linked_Interface->size())
+    {
+        chosen = (*linked_Interface)[button]; 
+    }
+
+    if (chosen == &Interface::Back && NavHistory::depth() == 0)
+    {
+        chosen = nullptr;   // nothing to go back to
+    }
+
+    if (chosen && this->transition(button, ITF_TRANSITIONING))
+    {
+        this->stopUpdateTask();
+
+        uint32_t* snapshot = nullptr; 
+        if (chosen == &Interface::Back)
         {
-            this->InterfaceChooser();
-            if (this->linked_Interface && this->index > -1)
-            {
-                Interface* chosen = (*linked_Interface)[this->index];  
-                chosen->setIndex(-1); 
-                this->stopUpdateTask();
-                Brain.Screen.clearScreen(); 
-                chosen->Display();
-                this->Action(); 
-                this->index = -2;
-            }
+            chosen = NavHistory::pop(&snapshot); 
+        }
+        else if (chosen != this && !NavHistory::unwind(chosen, &snapshot))
+        {
+            NavHistory::push(this, this->frame); 
+            this->frame = nullptr; 
+        }
+        if (chosen != this && this->frame)
+        {
+            // left for a screen below it in the history: nothing will
+            // restore this frame, so give its memory back to the budget
+            NavHistory::freeSnapshot(this->frame); 
+            this->frame = nullptr; 
+        }
+
+        chosen->setIndex(ITF_ACTIVE); 
+        if (snapshot)
+        {
+            chosen->Restore(snapshot); 
+        }
+        else
+        {
+            Brain.Screen.clearScreen(); 
+            chosen->Display();
+        }
+        this->Action(button); 
+        Perf::presented(); 
+        if (chosen != this)
+        {
+            this->transition(ITF_TRANSITIONING, ITF_INACTIVE); 
         }
-        Interface::isActive = 1;
+    }
+    else
+    {
+        // button without a linked interface: run its action and stay here
+        this->Action(button); 
+        Perf::presented(); 
+        this->transition(button, ITF_ACTIVE); 
     }
 }
 
@@ -219,12 +475,204 @@ void Interface::reset()
 {
     if (Brain.Screen.pressing())
     {
+        Perf::touched(); 
+        IdlePolicy::activity(); 
+        InputRecorder::touch(true, Brain.Screen.xPosition(), Brain.Screen.yPosition()); 
         waitUntil(!Brain.Screen.pressing());
         brain_x = Brain.Screen.xPosition();
         brain_y = Brain.Screen.yPosition();
-        isActive = 0;
+        InputRecorder::touch(false, brain_x, brain_y); 
+        isActive.store(0);
     }
 }
 /* ---------- Interface Class Ends ---------- */
 
-/* ---------- Auton Class comming soon.... ---------- */
\ No newline at end of file
+
+/* ---------- NavHistory Class ---------- */
+
+void NavHistory::push(Interface* itf, uint32_t* snapshot)
+{
+    if (count == NAV_HISTORY_DEPTH)
+    {
+        // full: forget the oldest screen
+        freeSnapshot(stack[0].snapshot); 
+        for (int i = 1; i < count; i++)
+        {
+            stack[i - 1] = stack[i]; 
+        }
+        count--; 
+    }
+    stack[count].itf = itf; 
+    stack[count].snapshot = snapshot; 
+    count++; 
+}
+Interface* NavHistory::pop(uint32_t** snapshot)
+{
+    *snapshot = nullptr; 
+    if (count == 0)
+    {
+        return nullptr; 
+    }
+    count--; 
+    *snapshot = stack[count].snapshot; 
+    return stack[count].itf; 
+}
+bool NavHistory::unwind(Interface* itf, uint32_t** snapshot)
+{
+    *snapshot = nullptr; 
+    for (int i = count - 1; i >= 0; i--)
+    {
+        if (stack[i].itf == itf)
+        {
+            for (int j = count - 1; j > i; j--)
+            {
+                freeSnapshot(stack[j].snapshot); 
+            }
+            count = i; 
+            *snapshot = stack[i].snapshot; 
+            return true; 
+        }
+    }
+    return false; 
+}
+void NavHistory::clear()
+{
+    for (int i = 0; i < count; i++)
+    {
+        freeSnapshot(stack[i].snapshot); 
+    }
+    count = 0; 
+}
+int NavHistory::depth()
+{
+    return count; 
+}
+void NavHistory::setSnapshotBudget(uint32_t bytes)
+{
+    snapshotBudget = bytes; 
+    for (int i = 0; i < count && snapshotBytes > snapshotBudget; i++)
+    {
+        freeSnapshot(stack[i].snapshot); 
+        stack[i].snapshot = nullptr; 
+    }
+}
+uint32_t NavHistory::getSnapshotBytes()
+{
+    return snapshotBytes; 
+}
+uint32_t* NavHistory::allocSnapshot()
+{
+    // make room by releasing the oldest retained snapshots
+    for (int i = 0; i < count && snapshotBytes + FRAME_BYTES > snapshotBudget; i++)
+    {
+        freeSnapshot(stack[i].snapshot); 
+        stack[i].snapshot = nullptr; 
+    }
+    if (snapshotBytes + FRAME_BYTES > snapshotBudget)
+    {
+        return nullptr; 
+    }
+    HeapScope scope(HEAP_HISTORY); 
+    uint32_t* snapshot = new (std::nothrow) uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT]; 
+    if (snapshot)
+    {
+        snapshotBytes += FRAME_BYTES; 
+    }
+    return snapshot; 
+}
+void NavHistory::freeSnapshot(uint32_t* snapshot)
+{
+    if (snapshot)
+    {
+        delete[] snapshot; 
+        snapshotBytes -= FRAME_BYTES; 
+    }
+}
+/* ---------- NavHistory Class Ends ---------- */
+
+
+
+/* ---------- Auton Class ---------- */
+
+Auton::Entry Auton::table[AUTON_MAX_ROUTINES];
+int Auton::count = 0;
+std::atomic<int> Auton::selected(-1);
+std::atomic<Auton::Routine> Auton::dispatch(nullptr);
+
+int Auton::add(const char* name, Routine routine, Routine setup)
+{
+    if (count >= AUTON_MAX_ROUTINES || !routine)
+    {
+        return -1; 
+    }
+    table[count].name = name; 
+    table[count].routine = routine; 
+    table[count].setup = setup; 
+    table[count].prepared = false; 
+    return count++; 
+}
+int Auton::find(const char* name)
+{
+    if (!name)
+    {
+        return -1; 
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(table[i].name, name) == 0)
+        {
+            return i; 
+        }
+    }
+    return -1; 
+}
+bool Auton::select(int id)
+{
+    if (id < 0 || id >= count)
+    {
+        return false; 
+    }
+    if (table[id].setup && !table[id].prepared)
+    {
+        table[id].setup(); 
+        table[id].prepared = true; 
+    }
+    dispatch.store(table[id].routine); 
+    selected.store(id); 
+    return true; 
+}
+int Auton::getSelected()
+{
+    return selected.load(); 
+}
+const char* Auton::getName(int id)
+{
+    if (id < 0 || id >= count)
+    {
+        return nullptr; 
+    }
+    return table[id].name; 
+}
+int Auton::size()
+{
+    return count; 
+}
+ActionCallback Auton::selector(const std::vector<const char*>* names)
+{
+    return [names](int button)
+    {
+        if (button >= 0 && (size_t)button < names->size() && (*names)[button])
+        {
+            Auton::select(Auton::find((*names)[button])); 
+        }
+    };
+}
+void Auton::run()
+{
+    Routine routine = dispatch.load(); 
+    if (routine)
+    {
+        routine(); 
+    }
+}
+/* ---------- Auton Class Ends ---------- */
\ No newline at end of file
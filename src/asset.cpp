@@ -0,0 +1,225 @@
+#include "vex.h"
+
+#define ASSET_CHUNK_WORDS (ASSET_CHUNK_BYTES / 4)
+#define ASSET_RUN_SKIP    0x80000000u
+#define ASSET_RUN_MAX     128
+
+/* ---------- Decoding ---------- */
+
+// receives each decoded span, in image coordinates
+typedef void (*SpanSink)(void* context, uint32_t rgb, int x, int y, int length);
+
+static bool decodeAsset(const char* filename, SpanSink sink, void* context)
+{
+    HeapScope scope(HEAP_ASSETS);   // whatever the file API allocates
+    FIL_T* file = vexFileOpen(filename, "");
+    if (!file)
+    {
+        return false;
+    }
+
+    AssetHeader header;
+    bool ok = vexFileRead((char*)&header, 1, sizeof(header), file) == (int32_t)sizeof(header) &&
+              header.magic == ASSET_MAGIC && header.version == ASSET_VERSION &&
+              header.width > 0 && header.height > 0;
+
+    uint32_t chunk[ASSET_CHUNK_WORDS];
+    uint32_t remaining = ok ? header.words : 0;
+    int x = 0, y = 0;
+    uint32_t spanColor = 0;
+    int spanX = 0, spanLength = 0;
+
+    while (remaining > 0 && y < header.height)
+    {
+        int words = remaining < ASSET_CHUNK_WORDS ? (int)remaining : ASSET_CHUNK_WORDS;
+        if (vexFileRead((char*)chunk, 1, words * 4, file) != words * 4)
+        {
+            ok = false;         // truncated: keep what was drawn
+            break;
+        }
+        remaining -= words;
+
+        for (int i = 0; i < words && y < header.height; i++)
+        {
+            uint32_t word = chunk[i];
+            bool skip = (word & ASSET_RUN_SKIP) != 0;
+            uint32_t rgb = word & 0xFFFFFF;
+            int count = (int)((word >> 24) & 0x7F) + 1;
+            while (count > 0 && y < header.height)
+            {
+                int n = count < header.width - x ? count : header.width - x;
+                if (skip || rgb != spanColor || spanX + spanLength != x)
+                {
+                    // a new span: hand the finished one over first
+                    if (spanLength)
+                    {
+                        sink(context, spanColor, spanX, y, spanLength);
+                    }
+                    spanLength = 0;
+                    spanColor = rgb;
+                    spanX = x;
+                }
+                spanLength += skip ? 0 : n;
+                x += n;
+                count -= n;
+                if (x == header.width)
+                {
+                    if (spanLength)
+                    {
+                        sink(context, spanColor, spanX, y, spanLength);
+                    }
+                    spanLength = 0;
+                    x = 0;
+                    y++;
+                }
+            }
+        }
+    }
+    if (spanLength)
+    {
+        sink(context, spanColor, spanX, y, spanLength);
+    }
+    vexFileClose(file);
+    return ok && remaining == 0;
+}
+
+struct ScreenTarget
+{
+    int x, y;
+};
+static void drawSpan(void* context, uint32_t rgb, int x, int y, int length)
+{
+    ScreenTarget* target = static_cast<ScreenTarget*>(context);
+    drawImageSpan(rgb, target->x + x, target->y + y, length);
+}
+static void storeSpan(void* context, uint32_t rgb, int x, int y, int length)
+{
+    uint32_t* frame = static_cast<uint32_t*>(context);
+    if (y >= SCREEN_HEIGHT || x >= SCREEN_WIDTH)
+    {
+        return;
+    }
+    int end = x + length < SCREEN_WIDTH ? x + length : SCREEN_WIDTH;
+    fillPixels(frame + y * SCREEN_WIDTH + x, rgb, end - x);
+}
+
+bool drawAsset(const char* filename, int x, int y)
+{
+    ScreenTarget target = { x, y };
+    return decodeAsset(filename, drawSpan, &target);
+}
+bool loadAsset(const char* filename, uint32_t* frame)
+{
+    return frame && decodeAsset(filename, storeSpan, frame);
+}
+
+
+/* ---------- Encoding ---------- */
+
+// length of the run starting at pixels[0], at most ASSET_RUN_MAX and count
+static int runLength(const uint32_t* pixels, int count)
+{
+    uint32_t rgb = pixels[0] & 0xFFFFFF;
+    int n = 1;
+    while (n < count && n < ASSET_RUN_MAX && (pixels[n] & 0xFFFFFF) == rgb)
+    {
+        n++;
+    }
+    return n;
+}
+
+AssetWriter::AssetWriter()
+: file(nullptr), used(0), key(ASSET_NO_KEY), ok(false)
+{
+}
+AssetWriter::~AssetWriter()
+{
+    close();
+}
+
+uint32_t AssetWriter::countRuns(const uint32_t* pixels, int count)
+{
+    uint32_t words = 0;
+    for (int i = 0; i < count; i += runLength(pixels + i, count - i))
+    {
+        words++;
+    }
+    return words;
+}
+
+bool AssetWriter::open(const char* filename, int width, int height, uint32_t words, uint32_t key)
+{
+    close();
+    if (width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF)
+    {
+        return false;
+    }
+    AssetHeader header;
+    header.magic = ASSET_MAGIC;
+    header.version = ASSET_VERSION;
+    header.width = (uint16_t)width;
+    header.height = (uint16_t)height;
+    header.flags = 0;
+    header.words = words;
+
+    HeapScope scope(HEAP_ASSETS);
+    file = vexFileOpenWrite(filename);
+    if (!file)
+    {
+        return false;
+    }
+    this->key = key;
+    used = 0;
+    ok = vexFileWrite((char*)&header, 1, sizeof(header), file) == (int32_t)sizeof(header);
+    return ok;
+}
+
+bool AssetWriter::write(const uint32_t* pixels, int count)
+{
+    if (!file)
+    {
+        return false;
+    }
+    for (int i = 0; i < count; )
+    {
+        uint32_t rgb = pixels[i] & 0xFFFFFF;
+        int n = runLength(pixels + i, count - i);
+        bool skip = key != ASSET_NO_KEY && rgb == (key & 0xFFFFFF);
+        chunk[used++] = (skip ? ASSET_RUN_SKIP : rgb) | ((uint32_t)(n - 1) << 24);
+        i += n;
+        if (used == ASSET_CHUNK_WORDS)
+        {
+            ok = ok && vexFileWrite((char*)chunk, 1, used * 4, file) == used * 4;
+            used = 0;
+        }
+    }
+    return ok;
+}
+
+bool AssetWriter::close()
+{
+    if (!file)
+    {
+        return false;
+    }
+    if (used)
+    {
+        ok = ok && vexFileWrite((char*)chunk, 1, used * 4, file) == used * 4;
+        used = 0;
+    }
+    vexFileClose(file);
+    file = nullptr;
+    return ok;
+}
+
+bool saveAsset(const char* filename, const uint32_t* pixels, int width, int height, uint32_t key)
+{
+    if (!pixels)
+    {
+        return false;
+    }
+    AssetWriter writer;
+    int total = width * height;
+    return writer.open(filename, width, height, AssetWriter::countRuns(pixels, total), key) &&
+           writer.write(pixels, total) && writer.close();
+}
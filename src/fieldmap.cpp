@@ -0,0 +1,350 @@
+#include "vex.h"
+
+#define FIELDMAP_TILE (FIELDMAP_SIZE / 6)       // pixels per field tile
+
+static const char* const fieldColor  = "#4A4A4A";
+static const char* const gridColor   = "#6E6E6E";
+static const char* const trailColor  = "#E0C020";
+static const char* const markerColor = "#3070C0";
+
+static int16_t clampMm(double cm)
+{
+    double mm = cm * 10;
+    return (int16_t)(mm > 32767 ? 32767 : (mm < -32767 ? -32767 : mm));
+}
+static int clampPixel(int v, int low, int high)
+{
+    return v < low ? low : (v > high ? high : v);
+}
+
+/* ---------- FieldMap Class ---------- */
+
+std::atomic<uint32_t> FieldMap::trail[FIELDMAP_TRAIL_POINTS];
+std::atomic<int> FieldMap::count(0);
+std::atomic<uint32_t> FieldMap::generation(0);
+std::atomic<uint32_t> FieldMap::cleared(0);
+std::atomic<bool> FieldMap::clearRequested(false);
+std::atomic<int32_t> FieldMap::poseX(0);
+std::atomic<int32_t> FieldMap::poseY(0);
+std::atomic<int32_t> FieldMap::poseHeading(0);
+std::atomic<bool> FieldMap::hasPose(false);
+double FieldMap::step = FIELDMAP_STEP_CM;
+double FieldMap::lastDirection = 0;
+std::atomic<bool> FieldMap::invalid(true);
+uint32_t FieldMap::shown[FIELDMAP_TRAIL_POINTS];
+int FieldMap::shownCount = 0;
+int FieldMap::drawnCount = 0;
+uint32_t FieldMap::drawnGeneration = 0;
+uint32_t FieldMap::drawnCleared = 0;
+bool FieldMap::markerDrawn = false;
+int FieldMap::markerX = 0;
+int FieldMap::markerY = 0;
+int FieldMap::markerHeading = 0;
+PoseProvider FieldMap::provider = nullptr;
+uint32_t FieldMap::samplePeriod = 20;
+task* FieldMap::sampler = nullptr;
+std::atomic<uint32_t> FieldMap::samples(0);
+std::atomic<uint32_t> FieldMap::thinned(0);
+std::atomic<uint32_t> FieldMap::segments(0);
+std::atomic<uint32_t> FieldMap::markers(0);
+
+uint32_t FieldMap::packPoint(double x, double y)
+{
+    return (uint16_t)clampMm(x) | ((uint32_t)(uint16_t)clampMm(y) << 16);
+}
+void FieldMap::toScreen(uint32_t point, int& px, int& py)
+{
+    double x = (int16_t)(point & 0xFFFF) / 10.0;
+    double y = (int16_t)(point >> 16) / 10.0;
+    px = FIELDMAP_LEFT + (int)((x + FIELDMAP_FIELD_CM / 2) * FIELDMAP_SIZE / FIELDMAP_FIELD_CM);
+    py = FIELDMAP_TOP + (int)((FIELDMAP_FIELD_CM / 2 - y) * FIELDMAP_SIZE / FIELDMAP_FIELD_CM);
+    px = clampPixel(px, FIELDMAP_LEFT, FIELDMAP_LEFT + FIELDMAP_SIZE);
+    py = clampPixel(py, FIELDMAP_TOP, FIELDMAP_TOP + FIELDMAP_SIZE);
+}
+
+void FieldMap::start(PoseProvider poseProvider, uint32_t periodMs)
+{
+    stop();
+    provider = poseProvider;
+    samplePeriod = periodMs ? periodMs : 1;
+    HeapScope scope(HEAP_TASKS);
+    sampler = new task(FieldMap::sampleTask);
+}
+void FieldMap::stop()
+{
+    if (sampler)
+    {
+        sampler->stop();
+        delete sampler;
+        sampler = nullptr;
+    }
+}
+int FieldMap::sampleTask()
+{
+    for (;;)
+    {
+        Pose pose;
+        if (provider && provider(pose))
+        {
+            add(pose.x, pose.y, pose.heading);
+        }
+        wait(samplePeriod, msec);
+    }
+    return 0;
+}
+
+void FieldMap::add(double x, double y, double heading)
+{
+    samples.fetch_add(1, std::memory_order_relaxed);
+    poseX.store((int32_t)(x * 10), std::memory_order_relaxed);
+    poseY.store((int32_t)(y * 10), std::memory_order_relaxed);
+    poseHeading.store((int32_t)(heading * 10), std::memory_order_relaxed);
+    hasPose.store(true);
+
+    if (clearRequested.exchange(false))
+    {
+        generation.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        count.store(0, std::memory_order_relaxed);
+        cleared.fetch_add(1, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+        step = FIELDMAP_STEP_CM;
+    }
+
+    int n = count.load(std::memory_order_relaxed);
+    if (n > 0)
+    {
+        uint32_t last = trail[n - 1].load(std::memory_order_relaxed);
+        double dx = x - (int16_t)(last & 0xFFFF) / 10.0;
+        double dy = y - (int16_t)(last >> 16) / 10.0;
+        double distance = sqrt(dx * dx + dy * dy);
+        if (distance < step)
+        {
+            return;
+        }
+
+        // keep corners, skip along straights
+        double direction = atan2(dx, dy) * 180 / pi;
+        double turn = fabs(direction - lastDirection);
+        if (turn > 180)
+        {
+            turn = 360 - turn;
+        }
+        if (n > 1 && turn < FIELDMAP_TURN_DEG && distance < step * FIELDMAP_STRAIGHT_STEPS)
+        {
+            return;
+        }
+        lastDirection = direction;
+    }
+
+    if (n == FIELDMAP_TRAIL_POINTS)
+    {
+        thin();
+        n = count.load(std::memory_order_relaxed);
+    }
+    trail[n].store(packPoint(x, y), std::memory_order_relaxed);
+    count.store(n + 1, std::memory_order_release);
+}
+void FieldMap::thin()
+{
+    // keep the first point, the last one and every other one between
+    generation.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    int kept = 1;
+    for (int i = 3; i < FIELDMAP_TRAIL_POINTS; i += 2)
+    {
+        trail[kept++].store(trail[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    count.store(kept, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+
+    step *= 2;
+    thinned.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FieldMap::clear()
+{
+    clearRequested.store(true);
+}
+
+bool FieldMap::copyTrail()
+{
+    uint32_t before = generation.load(std::memory_order_acquire);
+    if (before & 1)
+    {
+        return false;       // being thinned or cleared: try on the next pass
+    }
+    int n = count.load(std::memory_order_acquire);
+    for (int i = 0; i < n; i++)
+    {
+        shown[i] = trail[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (generation.load(std::memory_order_relaxed) != before)
+    {
+        return false;
+    }
+    shownCount = n;
+
+    // a thinned trail keeps about half the points already drawn
+    for (uint32_t g = drawnGeneration; g != before; g += 2)
+    {
+        drawnCount = drawnCount > 0 ? drawnCount / 2 + 1 : 0;
+    }
+    drawnGeneration = before;
+    if (drawnCount > n)
+    {
+        drawnCount = n;
+    }
+    return true;
+}
+
+int FieldMap::draw()
+{
+    uint32_t clears = cleared.load();
+    if (invalid.exchange(false) || clears != drawnCleared)
+    {
+        drawBackground();
+        drawnCount = 0;
+        drawnCleared = clears;
+        markerDrawn = false;
+    }
+    if (!copyTrail())
+    {
+        return 0;
+    }
+
+    // where the marker goes, kept inside the map
+    Pose pose;
+    bool moved = false;
+    int x = markerX, y = markerY, heading = markerHeading;
+    if (getPose(pose))
+    {
+        toScreen(packPoint(pose.x, pose.y), x, y);
+        x = clampPixel(x, FIELDMAP_LEFT + FIELDMAP_MARKER, FIELDMAP_LEFT + FIELDMAP_SIZE - FIELDMAP_MARKER);
+        y = clampPixel(y, FIELDMAP_TOP + FIELDMAP_MARKER, FIELDMAP_TOP + FIELDMAP_SIZE - FIELDMAP_MARKER);
+        heading = ((int)lround(pose.heading) % 360 + 360) % 360;
+        moved = !markerDrawn || x != markerX || y != markerY || heading != markerHeading;
+    }
+    if (moved && markerDrawn)
+    {
+        eraseMarker();
+    }
+
+    // only the segments added since the last pass
+    int drawn = 0;
+    Brain.Screen.setPenColor(trailColor);
+    for (int i = drawnCount > 0 ? drawnCount : 1; i < shownCount; i++)
+    {
+        int x1, y1, x2, y2;
+        toScreen(shown[i - 1], x1, y1);
+        toScreen(shown[i], x2, y2);
+        Brain.Screen.drawLine(x1, y1, x2, y2);
+        drawn++;
+    }
+    drawnCount = shownCount;
+
+    // the marker stays on top of the trail
+    if (moved || (drawn && markerDrawn))
+    {
+        drawMarker(x, y, heading);
+    }
+    if (moved)
+    {
+        markers.fetch_add(1, std::memory_order_relaxed);
+    }
+    segments.fetch_add(drawn, std::memory_order_relaxed);
+    return drawn;
+}
+void FieldMap::drawBackground()
+{
+    Brain.Screen.setPenColor(fieldColor);
+    Brain.Screen.setFillColor(fieldColor);
+    Brain.Screen.drawRectangle(FIELDMAP_LEFT, FIELDMAP_TOP, FIELDMAP_SIZE + 1, FIELDMAP_SIZE + 1);
+
+    Brain.Screen.setPenColor(gridColor);
+    for (int i = 0; i <= 6; i++)
+    {
+        int offset = i * FIELDMAP_TILE;
+        Brain.Screen.drawLine(FIELDMAP_LEFT + offset, FIELDMAP_TOP, FIELDMAP_LEFT + offset, FIELDMAP_TOP + FIELDMAP_SIZE);
+        Brain.Screen.drawLine(FIELDMAP_LEFT, FIELDMAP_TOP + offset, FIELDMAP_LEFT + FIELDMAP_SIZE, FIELDMAP_TOP + offset);
+    }
+}
+void FieldMap::drawMarker(int x, int y, int heading)
+{
+    Brain.Screen.setPenColor(white);
+    Brain.Screen.setFillColor(markerColor);
+    Brain.Screen.drawCircle(x, y, FIELDMAP_MARKER - 3);
+    Brain.Screen.drawLine(x, y, x + (int)lround(sin(heading * pi / 180) * FIELDMAP_MARKER),
+                          y - (int)lround(cos(heading * pi / 180) * FIELDMAP_MARKER));
+    markerX = x;
+    markerY = y;
+    markerHeading = heading;
+    markerDrawn = true;
+}
+void FieldMap::eraseMarker()
+{
+    int left = markerX - FIELDMAP_MARKER, right = markerX + FIELDMAP_MARKER;
+    int top = markerY - FIELDMAP_MARKER, bottom = markerY + FIELDMAP_MARKER;
+    Brain.Screen.setPenColor(fieldColor);
+    Brain.Screen.setFillColor(fieldColor);
+    Brain.Screen.drawRectangle(left, top, 2 * FIELDMAP_MARKER + 1, 2 * FIELDMAP_MARKER + 1);
+
+    // put back the grid and the trail under the box
+    Brain.Screen.setPenColor(gridColor);
+    for (int i = 0; i <= 6; i++)
+    {
+        int x = FIELDMAP_LEFT + i * FIELDMAP_TILE, y = FIELDMAP_TOP + i * FIELDMAP_TILE;
+        if (x >= left && x <= right)
+        {
+            Brain.Screen.drawLine(x, top, x, bottom);
+        }
+        if (y >= top && y <= bottom)
+        {
+            Brain.Screen.drawLine(left, y, right, y);
+        }
+    }
+    Brain.Screen.setPenColor(trailColor);
+    for (int i = 1; i < drawnCount; i++)
+    {
+        int x1, y1, x2, y2;
+        toScreen(shown[i - 1], x1, y1);
+        toScreen(shown[i], x2, y2);
+        bool apart = (x1 < left && x2 < left) || (x1 > right && x2 > right) ||
+                     (y1 < top && y2 < top) || (y1 > bottom && y2 > bottom);
+        if (!apart)
+        {
+            Brain.Screen.drawLine(x1, y1, x2, y2);
+        }
+    }
+    markerDrawn = false;
+}
+
+void FieldMap::invalidate()
+{
+    invalid.store(true);
+}
+
+bool FieldMap::getPose(Pose& pose)
+{
+    if (!hasPose.load())
+    {
+        return false;
+    }
+    pose.x = poseX.load(std::memory_order_relaxed) / 10.0;
+    pose.y = poseY.load(std::memory_order_relaxed) / 10.0;
+    pose.heading = poseHeading.load(std::memory_order_relaxed) / 10.0;
+    return true;
+}
+
+FieldMapStats FieldMap::getStats()
+{
+    FieldMapStats stats;
+    stats.samples = samples.load();
+    stats.points = (uint32_t)count.load();
+    stats.thinned = thinned.load();
+    stats.segments = segments.load();
+    stats.markers = markers.load();
+    return stats;
+}
+/* ---------- FieldMap Class Ends ---------- */
@@ -0,0 +1,365 @@
+#include "vex.h"
+
+/*  A block is packed in one word:
+
+      bits 0-3    row of its top edge
+      bits 4-7    column of its left edge
+      bits 8-11   width - 1
+      bits 12-15  height - 1
+      bit 16      ink (otherwise paper)  */
+
+#define GLYPH_INK (1u << 16)
+
+/* ---------- Fonts ---------- */
+
+static const uint8_t font5x7Rows[] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // space
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20,     // !
+    0x50, 0x50, 0x50, 0x00, 0x00, 0x00, 0x00,     // "
+    0x50, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0x50,     // #
+    0x20, 0x78, 0xA0, 0x70, 0x28, 0xF0, 0x20,     // $
+    0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18,     // %
+    0x60, 0x90, 0xA0, 0x40, 0xA8, 0x90, 0x68,     // &
+    0x60, 0x20, 0x40, 0x00, 0x00, 0x00, 0x00,     // '
+    0x10, 0x20, 0x40, 0x40, 0x40, 0x20, 0x10,     // (
+    0x40, 0x20, 0x10, 0x10, 0x10, 0x20, 0x40,     // )
+    0x00, 0x50, 0x20, 0xF8, 0x20, 0x50, 0x00,     // *
+    0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00,     // +
+    0x00, 0x00, 0x00, 0x00, 0x60, 0x20, 0x40,     // ,
+    0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00,     // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60,     // .
+    0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00,     // /
+    0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70,     // 0
+    0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70,     // 1
+    0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8,     // 2
+    0xF8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70,     // 3
+    0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10,     // 4
+    0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70,     // 5
+    0x30, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70,     // 6
+    0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40,     // 7
+    0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70,     // 8
+    0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60,     // 9
+    0x00, 0x60, 0x60, 0x00, 0x60, 0x60, 0x00,     // :
+    0x00, 0x60, 0x60, 0x00, 0x60, 0x20, 0x40,     // ;
+    0x08, 0x10, 0x20, 0x40, 0x20, 0x10, 0x08,     // <
+    0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00,     // =
+    0x80, 0x40, 0x20, 0x10, 0x20, 0x40, 0x80,     // >
+    0x70, 0x88, 0x08, 0x10, 0x20, 0x00, 0x20,     // ?
+    0x70, 0x88, 0x08, 0x68, 0xA8, 0xA8, 0x70,     // @
+    0x70, 0x88, 0x88, 0x88, 0xF8, 0x88, 0x88,     // A
+    0xF0, 0x88, 0x88, 0xF0, 0x88, 0x88, 0xF0,     // B
+    0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70,     // C
+    0xE0, 0x90, 0x88, 0x88, 0x88, 0x90, 0xE0,     // D
+    0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8,     // E
+    0xF8, 0x80, 0x80, 0xE0, 0x80, 0x80, 0x80,     // F
+    0x70, 0x88, 0x80, 0x80, 0x98, 0x88, 0x70,     // G
+    0x88, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88,     // H
+    0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70,     // I
+    0x38, 0x10, 0x10, 0x10, 0x10, 0x90, 0x60,     // J
+    0x88, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x88,     // K
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8,     // L
+    0x88, 0xD8, 0xA8, 0x88, 0x88, 0x88, 0x88,     // M
+    0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88,     // N
+    0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70,     // O
+    0xF0, 0x88, 0x88, 0xF0, 0x80, 0x80, 0x80,     // P
+    0x70, 0x88, 0x88, 0x88, 0xA8, 0x90, 0x68,     // Q
+    0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88,     // R
+    0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xF0,     // S
+    0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // T
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70,     // U
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20,     // V
+    0x88, 0x88, 0x88, 0xA8, 0xA8, 0xD8, 0x88,     // W
+    0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88,     // X
+    0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20,     // Y
+    0xF8, 0x08, 0x10, 0x20, 0x40, 0x80, 0xF8,     // Z
+    0x38, 0x20, 0x20, 0x20, 0x20, 0x20, 0x38,     // [
+    0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00,     // backslash
+    0xE0, 0x20, 0x20, 0x20, 0x20, 0x20, 0xE0,     // ]
+    0x20, 0x50, 0x88, 0x00, 0x00, 0x00, 0x00,     // ^
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8,     // _
+    0x40, 0x20, 0x10, 0x00, 0x00, 0x00, 0x00,     // `
+    0x00, 0x00, 0x70, 0x08, 0x78, 0x88, 0x78,     // a
+    0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0xF0,     // b
+    0x00, 0x00, 0x70, 0x80, 0x80, 0x88, 0x70,     // c
+    0x08, 0x08, 0x68, 0x98, 0x88, 0x88, 0x78,     // d
+    0x00, 0x00, 0x70, 0x88, 0xF8, 0x80, 0x70,     // e
+    0x30, 0x48, 0x40, 0xE0, 0x40, 0x40, 0x40,     // f
+    0x00, 0x00, 0x78, 0x88, 0x78, 0x08, 0x30,     // g
+    0x80, 0x80, 0xB0, 0xC8, 0x88, 0x88, 0x88,     // h
+    0x20, 0x00, 0x60, 0x20, 0x20, 0x20, 0x70,     // i
+    0x10, 0x00, 0x30, 0x10, 0x10, 0x90, 0x60,     // j
+    0x40, 0x40, 0x48, 0x50, 0x60, 0x50, 0x48,     // k
+    0x60, 0x20, 0x20, 0x20, 0x20, 0x20, 0x70,     // l
+    0x00, 0x00, 0xD0, 0xA8, 0xA8, 0x88, 0x88,     // m
+    0x00, 0x00, 0xB0, 0xC8, 0x88, 0x88, 0x88,     // n
+    0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70,     // o
+    0x00, 0x00, 0xF0, 0x88, 0xF0, 0x80, 0x80,     // p
+    0x00, 0x00, 0x68, 0x98, 0x78, 0x08, 0x08,     // q
+    0x00, 0x00, 0xB0, 0xC8, 0x80, 0x80, 0x80,     // r
+    0x00, 0x00, 0x70, 0x80, 0x70, 0x08, 0xF0,     // s
+    0x40, 0x40, 0xE0, 0x40, 0x40, 0x48, 0x30,     // t
+    0x00, 0x00, 0x88, 0x88, 0x88, 0x98, 0x68,     // u
+    0x00, 0x00, 0x88, 0x88, 0x88, 0x50, 0x20,     // v
+    0x00, 0x00, 0x88, 0x88, 0xA8, 0xA8, 0x50,     // w
+    0x00, 0x00, 0x88, 0x50, 0x20, 0x50, 0x88,     // x
+    0x00, 0x00, 0x88, 0x88, 0x78, 0x08, 0x70,     // y
+    0x00, 0x00, 0xF8, 0x10, 0x20, 0x40, 0xF8,     // z
+    0x10, 0x20, 0x20, 0x40, 0x20, 0x20, 0x10,     // {
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,     // |
+    0x40, 0x20, 0x20, 0x10, 0x20, 0x20, 0x40,     // }
+    0x00, 0x00, 0x40, 0xA8, 0x10, 0x00, 0x00,     // ~
+};
+const GlyphFont glyphFont5x7 = { 5, 7, 1, ' ', 95, font5x7Rows };
+
+static const uint8_t fontDigitsRows[] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // space
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // !
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // "
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // #
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // $
+    0x61, 0x93, 0x96, 0x6C, 0x0C, 0x18, 0x30, 0x30, 0x66, 0xC9, 0x89, 0x06,     // %
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // &
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // '
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // (
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // )
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // *
+    0x00, 0x00, 0x18, 0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0x18, 0x00, 0x00,     // +
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // ,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00,     // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18,     // .
+    0x03, 0x03, 0x06, 0x06, 0x0C, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60,     // /
+    0x3C, 0x7E, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x7E, 0x3C,     // 0
+    0x18, 0x38, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x7E,     // 1
+    0x3C, 0x66, 0xC3, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xFF, 0xFF,     // 2
+    0x3C, 0x66, 0xC3, 0x03, 0x06, 0x1C, 0x06, 0x03, 0xC3, 0xC3, 0x66, 0x3C,     // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xC6, 0xFF, 0xFF, 0x06, 0x06, 0x06,     // 4
+    0xFF, 0xC0, 0xC0, 0xC0, 0xDC, 0xE6, 0x03, 0x03, 0xC3, 0xC3, 0x66, 0x3C,     // 5
+    0x1C, 0x30, 0x60, 0xC0, 0xDC, 0xE6, 0xC3, 0xC3, 0xC3, 0xC3, 0x66, 0x3C,     // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x06, 0x0C, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x30,     // 7
+    0x3C, 0x66, 0xC3, 0xC3, 0x66, 0x3C, 0x66, 0xC3, 0xC3, 0xC3, 0x66, 0x3C,     // 8
+    0x3C, 0x66, 0xC3, 0xC3, 0xC3, 0xC3, 0x67, 0x3B, 0x03, 0x06, 0x0C, 0x38,     // 9
+    0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00,     // :
+};
+const GlyphFont glyphFontDigits = { 8, 12, 1, ' ', 27, fontDigitsRows };
+
+GlyphAtlas glyphSmall(glyphFont5x7);
+GlyphAtlas glyphDigits(glyphFontDigits);
+
+/* ---------- Fonts Ends ---------- */
+
+
+/* ---------- GlyphAtlas Class ---------- */
+
+// cuts one glyph into blocks; out holds (width + spacing) * height words
+static int cutGlyph(const GlyphFont& font, int glyph, uint32_t* out)
+{
+    int n = 0;
+    int columns = font.width + font.spacing;
+    for (int row = 0; row < font.height; row++)
+    {
+        uint8_t bits = font.rows[glyph * font.height + row];
+        int x = 0;
+        while (x < columns)
+        {
+            bool ink = x < font.width && (bits & (0x80 >> x));
+            int length = 1;
+            while (x + length < columns && (x + length < font.width && (bits & (0x80 >> (x + length)))) == ink)
+            {
+                length++;
+            }
+
+            // the same run on the row above: make that block taller
+            uint32_t run = (x << 4) | ((length - 1) << 8) | (ink ? GLYPH_INK : 0);
+            int above = -1;
+            for (int i = 0; i < n; i++)
+            {
+                uint32_t b = out[i];
+                if ((b & ~0xF00Fu) == run && (b & 0xF) + ((b >> 12) & 0xF) + 1 == (uint32_t)row)
+                {
+                    above = i;
+                }
+            }
+            if (above >= 0)
+            {
+                out[above] += 1 << 12;
+            }
+            else
+            {
+                out[n++] = run | row;
+            }
+            x += length;
+        }
+    }
+    return n;
+}
+
+GlyphAtlas::GlyphAtlas (const GlyphFont& font)
+    : font(&font), blocks(nullptr), firstBlock(nullptr), blockCount(0)
+{
+    uint32_t scratch[16 * 16];
+    int total = 0;
+    for (int g = 0; g < font.count; g++)
+    {
+        total += cutGlyph(font, g, scratch);
+    }
+    HeapScope scope(HEAP_RENDER);
+    this->blocks = new (std::nothrow) uint32_t[total];
+    this->firstBlock = new (std::nothrow) uint16_t[font.count + 1];
+    if (!this->blocks || !this->firstBlock)
+    {
+        delete[] this->blocks;
+        delete[] this->firstBlock;
+        this->blocks = nullptr;
+        this->firstBlock = nullptr;
+        return;
+    }
+    for (int g = 0; g < font.count; g++)
+    {
+        this->firstBlock[g] = this->blockCount;
+        this->blockCount += cutGlyph(font, g, this->blocks + this->blockCount);
+    }
+    this->firstBlock[font.count] = this->blockCount;
+}
+GlyphAtlas::~GlyphAtlas ()
+{
+    delete[] this->blocks;
+    delete[] this->firstBlock;
+}
+
+bool GlyphAtlas::isReady() const
+{
+    return this->blocks != nullptr;
+}
+int GlyphAtlas::size() const
+{
+    return this->blockCount;
+}
+int GlyphAtlas::cellWidth(int scale) const
+{
+    return (this->font->width + this->font->spacing) * scale;
+}
+int GlyphAtlas::cellHeight(int scale) const
+{
+    return this->font->height * scale;
+}
+
+int GlyphAtlas::drawGlyph(char c, int x, int y, int scale, uint32_t ink, uint32_t paper) const
+{
+    if (!this->blocks)
+    {
+        return 0;
+    }
+    int glyph = (unsigned char)c - (unsigned char)this->font->first;
+    if (glyph < 0 || glyph >= this->font->count)
+    {
+        // not in the font: a blank cell
+        if (paper & RENDER_TRANSPARENT)
+        {
+            return 0;
+        }
+        drawImageBlock(paper, x, y, this->cellWidth(scale), this->cellHeight(scale));
+        return 1;
+    }
+
+    int drawn = 0;
+    for (int i = this->firstBlock[glyph]; i < this->firstBlock[glyph + 1]; i++)
+    {
+        uint32_t b = this->blocks[i];
+        uint32_t rgb = (b & GLYPH_INK) ? ink : paper;
+        if (rgb & RENDER_TRANSPARENT)
+        {
+            continue;
+        }
+        drawImageBlock(rgb, x + ((b >> 4) & 0xF) * scale, y + (b & 0xF) * scale, 
+                       (((b >> 8) & 0xF) + 1) * scale, (((b >> 12) & 0xF) + 1) * scale);
+        drawn++;
+    }
+    return drawn;
+}
+int GlyphAtlas::drawText(const char* text, int x, int y, int scale, uint32_t ink, uint32_t paper) const
+{
+    int drawn = 0;
+    for (; text && *text; text++, x += this->cellWidth(scale))
+    {
+        drawn += this->drawGlyph(*text, x, y, scale, ink, paper);
+    }
+    return drawn;
+}
+/* ---------- GlyphAtlas Class Ends ---------- */
+
+
+/* ---------- GlyphText Class ---------- */
+
+GlyphText::GlyphText (const GlyphAtlas& atlas, int x, int y, int cells, int scale, GlyphAlign align)
+    : atlas(&atlas), x(x), y(y), scale(scale), align(align), ink(0xFFFFFF), paper(0x000000), 
+      valid(false), generation(0)
+{
+    this->cells = cells < 0 ? 0 : (cells > GLYPH_TEXT_CELLS ? GLYPH_TEXT_CELLS : cells);
+    memset(this->shown, ' ', sizeof(this->shown));
+}
+
+void GlyphText::setColors(uint32_t ink, uint32_t paper)
+{
+    if (ink != this->ink || paper != this->paper)
+    {
+        this->ink = ink;
+        this->paper = paper;
+        this->valid = false;
+    }
+}
+
+int GlyphText::set(const char* text)
+{
+    char next[GLYPH_TEXT_CELLS];
+    int length = text ? strlen(text) : 0;
+    length = length < this->cells ? length : this->cells;
+    int pad = this->align == GLYPH_RIGHT ? this->cells - length : 0;
+    memset(next, ' ', sizeof(next));
+    if (length > 0)
+    {
+        memcpy(next + pad, text, length);
+    }
+
+    // a new screen has covered the cells
+    uint32_t current = getScreenGeneration();
+    if (current != this->generation)
+    {
+        this->generation = current;
+        this->valid = false;
+    }
+
+    int drawn = 0;
+    int cell = this->atlas->cellWidth(this->scale);
+    for (int i = 0; i < this->cells; i++)
+    {
+        if (!this->valid || next[i] != this->shown[i])
+        {
+            this->atlas->drawGlyph(next[i], this->x + i * cell, this->y, this->scale, this->ink, this->paper);
+            this->shown[i] = next[i];
+            drawn++;
+        }
+    }
+    this->valid = true;
+    return drawn;
+}
+int GlyphText::print(const char* format, ...)
+{
+    char text[GLYPH_TEXT_CELLS + 1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return this->set(text);
+}
+
+void GlyphText::invalidate()
+{
+    this->valid = false;
+}
+int GlyphText::width() const
+{
+    return this->cells * this->atlas->cellWidth(this->scale);
+}
+/* ---------- GlyphText Class Ends ---------- */
@@ -0,0 +1,236 @@
+#include "vex.h"
+
+/* ---------- MotorHealth Class ---------- */
+
+float MotorHealth::raw[MOTORHEALTH_MOTORS];
+float MotorHealth::average[MOTORHEALTH_MOTORS];
+float MotorHealth::rate[MOTORHEALTH_MOTORS];
+float MotorHealth::remaining[MOTORHEALTH_MOTORS];
+uint8_t MotorHealth::levels[MOTORHEALTH_MOTORS];
+bool MotorHealth::primed[MOTORHEALTH_MOTORS];
+motor* MotorHealth::motors[MOTORHEALTH_MOTORS];
+const char* MotorHealth::names[MOTORHEALTH_MOTORS];
+std::atomic<int> MotorHealth::motorCount(0);
+std::atomic<int16_t> MotorHealth::shownTemperature[MOTORHEALTH_MOTORS];
+std::atomic<int16_t> MotorHealth::shownRate[MOTORHEALTH_MOTORS];
+std::atomic<int16_t> MotorHealth::shownRemaining[MOTORHEALTH_MOTORS];
+std::atomic<uint8_t> MotorHealth::shownLevel[MOTORHEALTH_MOTORS];
+HealthListener MotorHealth::listeners[MOTORHEALTH_LISTENERS];
+std::atomic<int> MotorHealth::listenerCount(0);
+task* MotorHealth::sampler = nullptr;
+std::atomic<uint32_t> MotorHealth::samples(0);
+std::atomic<uint32_t> MotorHealth::alerts(0);
+
+int MotorHealth::watch(motor& m, const char* name)
+{
+    int found = find(m);
+    if (found >= 0)
+    {
+        return found;
+    }
+    int n = motorCount.load();
+    if (n >= MOTORHEALTH_MOTORS)
+    {
+        return -1;
+    }
+    motors[n] = &m;
+    names[n] = name;
+    shownRemaining[n].store(MOTORHEALTH_NEVER);
+    primed[n] = false;          // start its average from its first reading
+    motorCount.store(n + 1);    // the sampler only reads motors below the count
+    return n;
+}
+
+bool MotorHealth::subscribe(HealthListener listener)
+{
+    int n = listenerCount.load();
+    if (n >= MOTORHEALTH_LISTENERS)
+    {
+        return false;
+    }
+    listeners[n] = listener;
+    listenerCount.store(n + 1);     // the sampler only calls listeners below the count
+    return true;
+}
+
+void MotorHealth::reset()
+{
+    stop();
+    motorCount.store(0);
+    for (int i = 0; i < MOTORHEALTH_LISTENERS; i++)
+    {
+        listeners[i] = nullptr;
+    }
+    listenerCount.store(0);
+    for (int i = 0; i < MOTORHEALTH_MOTORS; i++)
+    {
+        raw[i] = average[i] = rate[i] = 0;
+        remaining[i] = MOTORHEALTH_NEVER;
+        levels[i] = HEALTH_OK;
+        primed[i] = false;
+        shownTemperature[i].store(0);
+        shownRate[i].store(0);
+        shownRemaining[i].store(MOTORHEALTH_NEVER);
+        shownLevel[i].store(HEALTH_OK);
+    }
+    samples.store(0);
+    alerts.store(0);
+}
+
+void MotorHealth::start()
+{
+    stop();
+    HeapScope scope(HEAP_TASKS);
+    sampler = new task(MotorHealth::sampleTask);
+}
+void MotorHealth::stop()
+{
+    if (sampler)
+    {
+        sampler->stop();
+        delete sampler;
+        sampler = nullptr;
+    }
+}
+int MotorHealth::sampleTask()
+{
+    uint32_t last = timer::system();
+    for (;;)
+    {
+        wait(MOTORHEALTH_PERIOD_MS, msec);
+        uint32_t now = timer::system();
+        sample((now - last ? now - last : 1) / 1000.0f);
+        last = now;
+    }
+    return 0;
+}
+
+void MotorHealth::sample(float dt)
+{
+    int n = motorCount.load();
+    for (int i = 0; i < n; i++)
+    {
+        raw[i] = (float)motors[i]->temperature(celsius);
+        if (!primed[i])
+        {
+            average[i] = raw[i];
+            rate[i] = 0;
+            primed[i] = true;
+        }
+    }
+    smooth(dt > 0 ? dt : MOTORHEALTH_PERIOD_MS / 1000.0f);
+
+    for (int i = 0; i < n; i++)
+    {
+        HealthLevel level = classify(i);
+        shownTemperature[i].store((int16_t)lroundf(average[i] * 10));
+        shownRate[i].store((int16_t)lroundf(rate[i] * 100));
+        shownRemaining[i].store((int16_t)remaining[i]);
+        shownLevel[i].store((uint8_t)level);
+        if (level != levels[i])
+        {
+            levels[i] = (uint8_t)level;
+            alerts.fetch_add(1);
+            int listening = listenerCount.load();
+            for (int j = 0; j < listening; j++)
+            {
+                listeners[j](i, level);
+            }
+        }
+    }
+    samples.fetch_add(1);
+}
+
+void MotorHealth::smooth(float dt)
+{
+    const float alpha = dt / (MOTORHEALTH_SMOOTH_S + dt);
+    const float beta = dt / (MOTORHEALTH_RATE_SMOOTH_S + dt);
+
+    // every slot, watched or not: a fixed trip count and selects, not branches
+    for (int i = 0; i < MOTORHEALTH_MOTORS; i++)
+    {
+        float next = average[i] + alpha * (raw[i] - average[i]);
+        float slope = rate[i] + beta * ((next - average[i]) / dt - rate[i]);
+        float heating = slope > 0.001f ? slope : 0.001f;
+        float left = slope > 0.001f ? (MOTORHEALTH_LIMIT_C - next) / heating : MOTORHEALTH_NEVER;
+        left = left > 0 ? left : 0;
+        average[i] = next;
+        rate[i] = slope;
+        remaining[i] = left < MOTORHEALTH_NEVER ? left : MOTORHEALTH_NEVER;
+    }
+}
+
+HealthLevel MotorHealth::classify(int i)
+{
+    // a level is kept until the motor is clearly below it
+    float hot = MOTORHEALTH_LIMIT_C - (levels[i] == HEALTH_HOT ? MOTORHEALTH_HYSTERESIS_C : 0);
+    float warm = MOTORHEALTH_WARM_C - (levels[i] >= HEALTH_WARM ? MOTORHEALTH_HYSTERESIS_C : 0);
+    float soon = MOTORHEALTH_WARN_S * (levels[i] >= HEALTH_WARM ? 2 : 1);
+    if (average[i] >= hot)
+    {
+        return HEALTH_HOT;
+    }
+    if (average[i] >= warm || remaining[i] < soon)
+    {
+        return HEALTH_WARM;
+    }
+    return HEALTH_OK;
+}
+
+int MotorHealth::count()
+{
+    return motorCount.load();
+}
+int MotorHealth::find(motor& m)
+{
+    int n = motorCount.load();
+    for (int i = 0; i < n; i++)
+    {
+        if (motors[i] == &m)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+const char* MotorHealth::name(int i)
+{
+    return i >= 0 && i < count() ? names[i] : "?";
+}
+double MotorHealth::temperature(int i)
+{
+    return i >= 0 && i < MOTORHEALTH_MOTORS ? shownTemperature[i].load() / 10.0 : 0;
+}
+double MotorHealth::heatingRate(int i)
+{
+    return i >= 0 && i < MOTORHEALTH_MOTORS ? shownRate[i].load() / 100.0 : 0;
+}
+int MotorHealth::timeToLimit(int i)
+{
+    return i >= 0 && i < MOTORHEALTH_MOTORS ? shownRemaining[i].load() : MOTORHEALTH_NEVER;
+}
+HealthLevel MotorHealth::level(int i)
+{
+    return i >= 0 && i < MOTORHEALTH_MOTORS ? (HealthLevel)shownLevel[i].load() : HEALTH_OK;
+}
+HealthLevel MotorHealth::worst()
+{
+    HealthLevel result = HEALTH_OK;
+    int n = count();
+    for (int i = 0; i < n; i++)
+    {
+        HealthLevel l = level(i);
+        result = l > result ? l : result;
+    }
+    return result;
+}
+
+uint32_t MotorHealth::sampleCount()
+{
+    return samples.load();
+}
+uint32_t MotorHealth::alertCount()
+{
+    return alerts.load();
+}
+/* ---------- MotorHealth Class Ends ---------- */
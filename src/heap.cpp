@@ -0,0 +1,211 @@
+#include "vex.h"
+
+#include <cstddef>
+#include <new>
+
+/* ---------- HeapTracker Class ---------- */
+
+std::atomic<uint32_t> HeapTracker::allocations[HEAP_TAGS + 1];
+std::atomic<uint32_t> HeapTracker::frees[HEAP_TAGS + 1];
+std::atomic<uint32_t> HeapTracker::bytes[HEAP_TAGS + 1];
+std::atomic<uint32_t> HeapTracker::peaks[HEAP_TAGS + 1];
+
+// the innermost HeapScope of this task
+#ifdef WLIC_HOST
+static thread_local int currentTag = HEAP_OTHER;    // host tasks are threads
+#else
+static int currentTag = HEAP_OTHER;                 // Brain tasks switch only at waits
+#endif
+
+/*  Every counted block starts with its size and tag. The header is padded
+    to the alignment malloc() gives, so the block handed out keeps it. */
+struct HeapHeader
+{
+    uint32_t size;
+    uint32_t tag;
+};
+static const size_t headerBytes = alignof(std::max_align_t) > sizeof(HeapHeader) ?
+                                  alignof(std::max_align_t) : sizeof(HeapHeader);
+
+static void raisePeak(std::atomic<uint32_t>& peak, uint32_t live)
+{
+    uint32_t seen = peak.load();
+    while (live > seen && !peak.compare_exchange_weak(seen, live))
+    {
+    }
+}
+
+void HeapTracker::count(int tag, uint32_t size)
+{
+    allocations[tag].fetch_add(1);
+    allocations[HEAP_TAGS].fetch_add(1);
+    raisePeak(peaks[tag], bytes[tag].fetch_add(size) + size);
+    raisePeak(peaks[HEAP_TAGS], bytes[HEAP_TAGS].fetch_add(size) + size);
+}
+void HeapTracker::uncount(int tag, uint32_t size)
+{
+    frees[tag].fetch_add(1);
+    frees[HEAP_TAGS].fetch_add(1);
+    bytes[tag].fetch_sub(size);
+    bytes[HEAP_TAGS].fetch_sub(size);
+}
+
+void* HeapTracker::allocate(size_t size)
+{
+    if (size > UINT32_MAX - headerBytes)
+    {
+        return nullptr;
+    }
+    uint8_t* block = static_cast<uint8_t*>(malloc(headerBytes + size));
+    if (!block)
+    {
+        return nullptr;
+    }
+    int tag = currentTag;
+    HeapHeader* header = reinterpret_cast<HeapHeader*>(block);
+    header->size = (uint32_t)size;
+    header->tag = (uint32_t)tag;
+    count(tag, (uint32_t)size);
+    return block + headerBytes;
+}
+void HeapTracker::release(void* block)
+{
+    if (!block)
+    {
+        return;
+    }
+    uint8_t* start = static_cast<uint8_t*>(block) - headerBytes;
+    const HeapHeader* header = reinterpret_cast<const HeapHeader*>(start);
+    uncount(header->tag, header->size);
+    free(start);
+}
+
+bool HeapTracker::isEnabled()
+{
+#ifdef WLIC_TRACK_MEMORY
+    return true;
+#else
+    return false;
+#endif
+}
+
+HeapStats HeapTracker::getStats()
+{
+    return getStats(HEAP_TAGS);
+}
+HeapStats HeapTracker::getStats(HeapTag tag)
+{
+    HeapStats stats = {};
+    if (tag < HEAP_OTHER || tag > HEAP_TAGS)
+    {
+        return stats;
+    }
+    stats.allocations = allocations[tag].load();
+    stats.frees = frees[tag].load();
+    stats.blocks = stats.allocations - stats.frees;
+    stats.bytes = bytes[tag].load();
+    stats.peak = peaks[tag].load();
+    return stats;
+}
+
+const char* HeapTracker::tagName(HeapTag tag)
+{
+    static const char* const names[] = { "other", "render", "tasks", "assets", "widgets", "history", "total" };
+    return tag >= HEAP_OTHER && tag <= HEAP_TAGS ? names[tag] : "?";
+}
+
+void HeapTracker::resetPeak()
+{
+    for (int tag = 0; tag <= HEAP_TAGS; tag++)
+    {
+        peaks[tag].store(bytes[tag].load());
+    }
+}
+
+int HeapTracker::report(char* out, int size)
+{
+    if (!out || size <= 0)
+    {
+        return 0;
+    }
+    int used = snprintf(out, size, "%-8s %10s %8s %10s %10s\n", "tag", "bytes", "blocks", "peak", "allocs");
+    for (int tag = 0; tag <= HEAP_TAGS && used < size; tag++)
+    {
+        HeapStats stats = getStats((HeapTag)tag);
+        used += snprintf(out + used, size - used, "%-8s %10lu %8lu %10lu %10lu\n", tagName((HeapTag)tag),
+                         (unsigned long)stats.bytes, (unsigned long)stats.blocks,
+                         (unsigned long)stats.peak, (unsigned long)stats.allocations);
+    }
+    return used < size ? used : size - 1;
+}
+/* ---------- HeapTracker Class Ends ---------- */
+
+
+/* ---------- HeapScope Class ---------- */
+
+HeapScope::HeapScope (HeapTag tag)
+    : previous(currentTag)
+{
+    currentTag = tag;
+}
+HeapScope::~HeapScope ()
+{
+    currentTag = this->previous;
+}
+/* ---------- HeapScope Class Ends ---------- */
+
+
+/* ---------- Global new and delete ---------- */
+
+#ifdef WLIC_TRACK_MEMORY
+// no exceptions to throw: running out of memory ends the program, as the
+// default operator new does when built with -fno-exceptions
+void* operator new(size_t size)
+{
+    void* block = HeapTracker::allocate(size);
+    if (!block)
+    {
+        abort();
+    }
+    return block;
+}
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return HeapTracker::allocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return HeapTracker::allocate(size);
+}
+void operator delete(void* block) noexcept
+{
+    HeapTracker::release(block);
+}
+void operator delete[](void* block) noexcept
+{
+    HeapTracker::release(block);
+}
+void operator delete(void* block, const std::nothrow_t&) noexcept
+{
+    HeapTracker::release(block);
+}
+void operator delete[](void* block, const std::nothrow_t&) noexcept
+{
+    HeapTracker::release(block);
+}
+// code compiled as C++14 or later (libstdc++ itself, for one) frees with
+// the sized forms; the block's header already holds its size
+void operator delete(void* block, size_t) noexcept
+{
+    HeapTracker::release(block);
+}
+void operator delete[](void* block, size_t) noexcept
+{
+    HeapTracker::release(block);
+}
+#endif
+/* ---------- Global new and delete Ends ---------- */
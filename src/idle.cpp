@@ -0,0 +1,156 @@
+#include "vex.h"
+
+/* ---------- IdlePolicy Class ---------- */
+
+std::atomic<uint32_t> IdlePolicy::timeout(IDLE_TIMEOUT_MS);
+std::atomic<uint32_t> IdlePolicy::lastActivity(0);
+std::atomic<bool> IdlePolicy::idle(false);
+std::atomic<uint32_t> IdlePolicy::modeStart(0);
+IdleProbe IdlePolicy::probes[IDLE_PROBES];
+double IdlePolicy::thresholds[IDLE_PROBES];
+double IdlePolicy::lastValues[IDLE_PROBES];
+std::atomic<int> IdlePolicy::probeCount(0);
+std::atomic<uint32_t> IdlePolicy::activeMs(0);
+std::atomic<uint32_t> IdlePolicy::idleMs(0);
+std::atomic<uint32_t> IdlePolicy::slept(0);
+std::atomic<uint32_t> IdlePolicy::woken(0);
+std::atomic<uint32_t> IdlePolicy::skipped(0);
+
+void IdlePolicy::setTimeout(uint32_t ms)
+{
+    timeout.store(ms);
+    activity();     // count the new timeout from now
+}
+uint32_t IdlePolicy::getTimeout()
+{
+    return timeout.load();
+}
+
+void IdlePolicy::begin(uint32_t now)
+{
+    // the clock starts at the first activity() or check()
+    uint32_t unset = 0;
+    modeStart.compare_exchange_strong(unset, now);
+    unset = 0;
+    lastActivity.compare_exchange_strong(unset, now);
+}
+void IdlePolicy::leaveMode(uint32_t now, bool wasIdle)
+{
+    uint32_t start = modeStart.exchange(now);
+    (wasIdle ? idleMs : activeMs).fetch_add(now - start);
+    (wasIdle ? woken : slept).fetch_add(1);
+}
+
+void IdlePolicy::activity()
+{
+    uint32_t now = timer::system();
+    begin(now);
+    lastActivity.store(now);
+    bool wasIdle = true;
+    if (idle.compare_exchange_strong(wasIdle, false))
+    {
+        leaveMode(now, true);
+    }
+}
+
+bool IdlePolicy::watch(IdleProbe probe, double threshold)
+{
+    int n = probeCount.load();
+    if (n >= IDLE_PROBES || !probe)
+    {
+        return false;
+    }
+    probes[n] = probe;
+    thresholds[n] = threshold;
+    lastValues[n] = probe();
+    probeCount.store(n + 1);
+    return true;
+}
+
+void IdlePolicy::check()
+{
+    int n = probeCount.load();
+    for (int i = 0; i < n; i++)
+    {
+        double value = probes[i]();
+        if (fabs(value - lastValues[i]) > thresholds[i])
+        {
+            lastValues[i] = value;
+            activity();
+        }
+    }
+
+    uint32_t now = timer::system();
+    begin(now);
+    uint32_t limit = timeout.load();
+    bool active = false;
+    if (limit && now - lastActivity.load() >= limit && idle.compare_exchange_strong(active, true))
+    {
+        leaveMode(now, false);
+    }
+}
+
+bool IdlePolicy::isIdle()
+{
+    return idle.load();
+}
+
+void IdlePolicy::pause(uint32_t ms, void (*poll)())
+{
+    if (!idle.load() || ms == 0)
+    {
+        wait(ms, msec);
+        return;
+    }
+
+    // each slice is a pass the loop would have run if it were active
+    uint32_t slices = 0;
+    for (uint32_t waited = 0; waited < IDLE_PERIOD_MS && idle.load(); waited += ms)
+    {
+        wait(ms, msec);
+        slices++;
+        if (poll)
+        {
+            poll();
+        }
+    }
+    if (slices > 1)
+    {
+        skipped.fetch_add(slices - 1);
+    }
+}
+
+void IdlePolicy::reset()
+{
+    probeCount.store(0);
+    for (int i = 0; i < IDLE_PROBES; i++)
+    {
+        probes[i] = nullptr;
+    }
+    uint32_t now = timer::system();
+    idle.store(false);
+    lastActivity.store(now);
+    modeStart.store(now);
+    activeMs.store(0);
+    idleMs.store(0);
+    slept.store(0);
+    woken.store(0);
+    skipped.store(0);
+}
+
+IdleStats IdlePolicy::getStats()
+{
+    uint32_t now = timer::system();
+    uint32_t start = modeStart.load();
+    uint32_t current = start ? now - start : 0;
+    bool isIdleNow = idle.load();
+
+    IdleStats stats;
+    stats.activeMs = activeMs.load() + (isIdleNow ? 0 : current);
+    stats.idleMs = idleMs.load() + (isIdleNow ? current : 0);
+    stats.slept = slept.load();
+    stats.woken = woken.load();
+    stats.skipped = skipped.load();
+    return stats;
+}
+/* ---------- IdlePolicy Class Ends ---------- */
@@ -45,6 +45,21 @@
 using namespace vex;
 competition Competition;
 
+/*---------------------------------------------------------------------------*/
+/*                           Autonomous Routines                             */
+/*                                                                           */
+/*  Each routine is registered with Auton::add() in pre_auton() under the    */
+/*  name used by the Red/Blue selector screens (see Monitor() in             */
+/*  display.cpp). Selecting a routine on the Brain stores it for             */
+/*  autonomous().                                                            */
+/*---------------------------------------------------------------------------*/
+void redAWP(void)   { /* ADD YOUR RED AWP ROUTINE HERE */ }
+void red1(void)     { /* ADD YOUR RED #1 ROUTINE HERE */ }
+void red2(void)     { /* ADD YOUR RED #2 ROUTINE HERE */ }
+void blueAWP(void)  { /* ADD YOUR BLUE AWP ROUTINE HERE */ }
+void blue1(void)    { /* ADD YOUR BLUE #1 ROUTINE HERE */ }
+void blue2(void)    { /* ADD YOUR BLUE #2 ROUTINE HERE */ }
+
 /*---------------------------------------------------------------------------*/
 /*                          Pre-Autonomous Functions                         */
 /*                                                                           */
@@ -52,6 +67,15 @@ competition Competition;
 /*---------------------------------------------------------------------------*/
 void pre_auton(void)
 {
+  // Register autonomous routines (an optional third argument runs one-time
+  // setup, such as path generation, as soon as the routine is selected)
+  Auton::add("Red AWP", redAWP);
+  Auton::add("Red 1", red1);
+  Auton::add("Red 2", red2);
+  Auton::add("Blue AWP", blueAWP);
+  Auton::add("Blue 1", blue1);
+  Auton::add("Blue 2", blue2);
+
   // Launch the WLIC interface system for autonomous selection and monitoring
   Monitor();
 
@@ -66,7 +90,8 @@ void pre_auton(void)
 /*---------------------------------------------------------------------------*/
 void autonomous(void)
 {
-  // ADD YOUR AUTONOMOUS CODE HERE
+  // Run the routine chosen on the Auton selector screens
+  Auton::run();
 }
 
 /*---------------------------------------------------------------------------*/
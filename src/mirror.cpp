@@ -0,0 +1,144 @@
+#include "vex.h"
+
+/* ---------- ControllerMirror Class ---------- */
+
+StatusChannel ControllerMirror::lines[MIRROR_ROWS] = { {""}, {""}, {""} };
+char ControllerMirror::shown[MIRROR_ROWS][MIRROR_COLUMNS + 1];
+int ControllerMirror::nextRow = 0;
+controller* ControllerMirror::target = nullptr;
+uint32_t ControllerMirror::period = MIRROR_WRITE_MS;
+std::atomic<bool> ControllerMirror::running(false);
+std::atomic<uint32_t> ControllerMirror::requests(0);
+std::atomic<uint32_t> ControllerMirror::writes(0);
+std::atomic<uint32_t> ControllerMirror::cells(0);
+task* ControllerMirror::flusher = nullptr;
+
+void ControllerMirror::start(controller& screen, uint32_t periodMs)
+{
+    stop();
+    target = &screen;
+    period = periodMs ? periodMs : 1;
+    requests.store(0);
+    writes.store(0);
+    cells.store(0);
+
+    // the screen starts blank, so only non-blank cells are ever sent
+    target->Screen.clearScreen();
+    for (int row = 0; row < MIRROR_ROWS; row++)
+    {
+        memset(shown[row], ' ', MIRROR_COLUMNS);
+        shown[row][MIRROR_COLUMNS] = 0;
+    }
+    nextRow = 0;
+
+    running.store(true);
+    HeapScope scope(HEAP_TASKS);
+    flusher = new task(ControllerMirror::flushTask);
+}
+void ControllerMirror::stop()
+{
+    running.store(false);
+    if (flusher)
+    {
+        flusher->stop();
+        delete flusher;
+        flusher = nullptr;
+    }
+}
+bool ControllerMirror::isRunning()
+{
+    return running.load(std::memory_order_relaxed);
+}
+
+void ControllerMirror::setLine(int row, const char* text)
+{
+    if (row < 0 || row >= MIRROR_ROWS)
+    {
+        return;
+    }
+    lines[row].set(text ? text : "");
+    requests.fetch_add(1, std::memory_order_relaxed);
+}
+void ControllerMirror::print(int row, const char* format, ...)
+{
+    char text[STATUS_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    setLine(row, text);
+}
+void ControllerMirror::clear()
+{
+    for (int row = 0; row < MIRROR_ROWS; row++)
+    {
+        setLine(row, "");
+    }
+}
+
+bool ControllerMirror::step()
+{
+    if (!target)
+    {
+        return false;
+    }
+    for (int n = 0; n < MIRROR_ROWS; n++)
+    {
+        int row = (nextRow + n) % MIRROR_ROWS;
+
+        char wanted[STATUS_LENGTH];
+        lines[row].get(wanted, sizeof(wanted));
+        int length = (int)strlen(wanted);
+        for (int col = length; col < MIRROR_COLUMNS; col++)
+        {
+            wanted[col] = ' ';
+        }
+        wanted[MIRROR_COLUMNS] = 0;
+
+        int first = 0, last = MIRROR_COLUMNS - 1;
+        while (first < MIRROR_COLUMNS && wanted[first] == shown[row][first])
+        {
+            first++;
+        }
+        if (first == MIRROR_COLUMNS)
+        {
+            continue;       // row already up to date
+        }
+        while (wanted[last] == shown[row][last])
+        {
+            last--;
+        }
+
+        // one cursor move and one print for the whole changed segment
+        int count = last - first + 1;
+        target->Screen.setCursor(row + 1, first + 1);
+        target->Screen.print("%.*s", count, wanted + first);
+        memcpy(shown[row] + first, wanted + first, count);
+        writes.fetch_add(1, std::memory_order_relaxed);
+        cells.fetch_add(count, std::memory_order_relaxed);
+
+        nextRow = (row + 1) % MIRROR_ROWS;
+        return true;
+    }
+    return false;
+}
+
+int ControllerMirror::flushTask()
+{
+    while (running.load())
+    {
+        step();
+        wait(period, msec);
+    }
+    return 0;
+}
+
+MirrorStats ControllerMirror::getStats()
+{
+    MirrorStats stats;
+    stats.requests = requests.load();
+    stats.writes = writes.load();
+    stats.cells = cells.load();
+    return stats;
+}
+/* ---------- ControllerMirror Class Ends ---------- */
@@ -0,0 +1,213 @@
+#include "vex.h"
+
+/* ---------- Histogram Class ---------- */
+
+Histogram::Histogram ()
+{
+    this->clear();
+}
+
+int Histogram::bucketOf(uint32_t value)
+{
+    if (value < 4)
+    {
+        return value;
+    }
+    int msb = 31 - __builtin_clz(value);
+    int bucket = (msb - 1) * 4 + ((value >> (msb - 2)) & 3);
+    return bucket < PERF_BUCKETS ? bucket : PERF_BUCKETS - 1;
+}
+uint32_t Histogram::bucketLimit(int bucket)
+{
+    if (bucket < 4)
+    {
+        return bucket;
+    }
+    int shift = bucket / 4 - 1;
+    return ((uint32_t)(4 + bucket % 4) << shift) + (1u << shift) - 1;
+}
+
+void Histogram::record(uint32_t value)
+{
+    counts[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    uint32_t seen = peak.load(std::memory_order_relaxed);
+    while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+    {
+    }
+}
+uint32_t Histogram::percentile(int p) const
+{
+    uint32_t n = total.load(std::memory_order_relaxed);
+    if (n == 0)
+    {
+        return 0;
+    }
+    uint32_t target = (uint32_t)(((uint64_t)n * p + 99) / 100);
+    target = target ? target : 1;
+    uint32_t seen = 0;
+    for (int b = 0; b < PERF_BUCKETS; b++)
+    {
+        seen += counts[b].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            uint32_t limit = bucketLimit(b);
+            uint32_t top = this->max();
+            return limit < top ? limit : top;
+        }
+    }
+    return this->max();
+}
+uint32_t Histogram::max() const
+{
+    return peak.load(std::memory_order_relaxed);
+}
+uint32_t Histogram::count() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+void Histogram::clear()
+{
+    for (int b = 0; b < PERF_BUCKETS; b++)
+    {
+        counts[b].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    peak.store(0, std::memory_order_relaxed);
+}
+/* ---------- Histogram Class Ends ---------- */
+
+
+/* ---------- Perf Class ---------- */
+
+std::atomic<bool> Perf::enabled(false);
+std::atomic<uint32_t> Perf::touchStart(0);
+std::atomic<uint32_t> Perf::lastLoop(0);
+Histogram Perf::loop;
+Histogram Perf::latency;
+Perf::Screen Perf::screens[PERF_MAX_SCREENS];
+
+uint32_t Perf::now()
+{
+    uint32_t t = (uint32_t)timer::systemHighResolution();
+    return t ? t : 1;       // 0 means "not timing"
+}
+
+void Perf::setEnabled(bool enable)
+{
+    touchStart.store(0);
+    lastLoop.store(0);
+    enabled.store(enable);
+}
+bool Perf::isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t Perf::begin()
+{
+    return enabled.load(std::memory_order_relaxed) ? now() : 0;
+}
+
+Perf::Screen* Perf::find(const void* key, const char* name)
+{
+    for (int i = 0; i < PERF_MAX_SCREENS; i++)
+    {
+        const void* owner = screens[i].key.load();
+        if (!owner && screens[i].key.compare_exchange_strong(owner, key))
+        {
+            owner = key;
+        }
+        if (owner == key)
+        {
+            if (name)
+            {
+                screens[i].name.store(name, std::memory_order_relaxed);
+            }
+            return &screens[i];
+        }
+    }
+    return nullptr;     // table full: not recorded
+}
+void Perf::endDraw(const void* key, const char* name, uint32_t start)
+{
+    if (start)
+    {
+        uint32_t elapsed = now() - start;
+        Screen* slot = find(key, name);
+        if (slot)
+        {
+            slot->draw.record(elapsed);
+        }
+    }
+}
+void Perf::endUpdate(const void* key, const char* name, uint32_t start)
+{
+    if (start)
+    {
+        uint32_t elapsed = now() - start;
+        Screen* slot = find(key, name);
+        if (slot)
+        {
+            slot->update.record(elapsed);
+        }
+    }
+}
+
+void Perf::touched()
+{
+    if (enabled.load(std::memory_order_relaxed))
+    {
+        touchStart.store(now(), std::memory_order_relaxed);
+    }
+}
+void Perf::presented()
+{
+    uint32_t start = touchStart.exchange(0, std::memory_order_relaxed);
+    if (start && enabled.load(std::memory_order_relaxed))
+    {
+        latency.record(now() - start);
+    }
+}
+void Perf::loopTick()
+{
+    if (enabled.load(std::memory_order_relaxed))
+    {
+        uint32_t t = now();
+        uint32_t last = lastLoop.exchange(t, std::memory_order_relaxed);
+        if (last)
+        {
+            loop.record(t - last);
+        }
+    }
+}
+
+const Histogram& Perf::loopPeriod()
+{
+    return loop;
+}
+const Histogram& Perf::touchLatency()
+{
+    return latency;
+}
+const Perf::Screen* Perf::screen(int i)
+{
+    if (i < 0 || i >= PERF_MAX_SCREENS || !screens[i].key.load())
+    {
+        return nullptr;
+    }
+    return &screens[i];
+}
+void Perf::clear()
+{
+    loop.clear();
+    latency.clear();
+    for (int i = 0; i < PERF_MAX_SCREENS; i++)
+    {
+        screens[i].draw.clear();
+        screens[i].update.clear();
+    }
+    touchStart.store(0);
+    lastLoop.store(0);
+}
+/* ---------- Perf Class Ends ---------- */
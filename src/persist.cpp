@@ -0,0 +1,178 @@
+#include "vex.h"
+
+/* ---------- UIState Class ---------- */
+
+UIStateRecord UIState::record;
+std::atomic<int32_t> UIState::settings[UI_STATE_SETTINGS];
+std::atomic<uint32_t> UIState::setMask(0);
+std::atomic<bool> UIState::dirty(false);
+uint32_t UIState::changedAt = 0;
+bool UIState::loaded = false;
+
+uint32_t UIState::checksum(const UIStateRecord& r)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&r);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(UIStateRecord, checksum); i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool UIState::readSlot(int slot, UIStateRecord& out)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%s.%d", UI_STATE_FILE, slot);
+    if (!Brain.SDcard.exists(name))
+    {
+        return false;
+    }
+    int32_t bytes = Brain.SDcard.loadfile(name, reinterpret_cast<uint8_t*>(&out), sizeof(out));
+    return bytes == (int32_t)sizeof(out) && out.magic == UI_STATE_MAGIC &&
+           out.version == UI_STATE_VERSION && out.size == sizeof(out) &&
+           out.checksum == checksum(out);
+}
+
+bool UIState::load()
+{
+    memset(&record, 0, sizeof(record));
+    loaded = false;
+    if (Brain.SDcard.isInserted())
+    {
+        UIStateRecord slots[2];
+        bool valid[2] = { readSlot(0, slots[0]), readSlot(1, slots[1]) };
+        int newest = -1;
+        if (valid[0] && valid[1])
+        {
+            // sequence comparison that survives wrap-around
+            newest = (int32_t)(slots[1].sequence - slots[0].sequence) > 0 ? 1 : 0;
+        }
+        else if (valid[0] || valid[1])
+        {
+            newest = valid[0] ? 0 : 1;
+        }
+        if (newest >= 0)
+        {
+            record = slots[newest];
+            record.screen[sizeof(record.screen) - 1] = 0;
+            record.routine[sizeof(record.routine) - 1] = 0;
+            loaded = true;
+        }
+    }
+    for (int i = 0; i < UI_STATE_SETTINGS; i++)
+    {
+        settings[i].store(record.settings[i]);
+    }
+    setMask.store(record.present);
+    dirty.store(false);
+    return loaded;
+}
+
+bool UIState::save()
+{
+    dirty.store(false);
+    if (!Brain.SDcard.isInserted())
+    {
+        return false;
+    }
+    UIStateRecord next = record;
+    next.magic = UI_STATE_MAGIC;
+    next.version = UI_STATE_VERSION;
+    next.size = sizeof(next);
+    next.sequence = record.sequence + 1;
+    next.present = setMask.load();
+    for (int i = 0; i < UI_STATE_SETTINGS; i++)
+    {
+        next.settings[i] = settings[i].load();
+    }
+    next.checksum = checksum(next);
+
+    // the newest record is in slot (sequence & 1): overwrite the other one
+    char name[32];
+    snprintf(name, sizeof(name), "%s.%d", UI_STATE_FILE, (int)(next.sequence & 1));
+    int32_t bytes = Brain.SDcard.savefile(name, reinterpret_cast<uint8_t*>(&next), sizeof(next));
+    if (bytes != (int32_t)sizeof(next))
+    {
+        return false;
+    }
+    record = next;
+    return true;
+}
+
+void UIState::markDirty()
+{
+    changedAt = timer::system();
+    dirty.store(true);
+}
+
+void UIState::poll()
+{
+    if (dirty.load(std::memory_order_relaxed) && timer::system() - changedAt >= UI_STATE_SAVE_DELAY)
+    {
+        save();
+    }
+}
+
+bool UIState::wasLoaded()
+{
+    return loaded;
+}
+
+void UIState::setScreen(const char* name)
+{
+    name = name ? name : "";
+    if (strncmp(record.screen, name, sizeof(record.screen) - 1) != 0)
+    {
+        strncpy(record.screen, name, sizeof(record.screen) - 1);
+        record.screen[sizeof(record.screen) - 1] = 0;
+        markDirty();
+    }
+}
+const char* UIState::getScreen()
+{
+    return record.screen;
+}
+void UIState::setRoutine(const char* name)
+{
+    name = name ? name : "";
+    if (strncmp(record.routine, name, sizeof(record.routine) - 1) != 0)
+    {
+        strncpy(record.routine, name, sizeof(record.routine) - 1);
+        record.routine[sizeof(record.routine) - 1] = 0;
+        markDirty();
+    }
+}
+const char* UIState::getRoutine()
+{
+    return record.routine;
+}
+
+void UIState::setSetting(int i, int32_t value)
+{
+    if (i < 0 || i >= UI_STATE_SETTINGS)
+    {
+        return;
+    }
+    uint32_t bit = 1u << i;
+    bool changed = settings[i].exchange(value) != value;
+    bool wasSet = (setMask.fetch_or(bit) & bit) != 0;
+    if (changed || !wasSet)
+    {
+        markDirty();
+    }
+}
+int32_t UIState::getSetting(int i, int32_t fallback)
+{
+    if (i < 0 || i >= UI_STATE_SETTINGS || !(setMask.load() & (1u << i)))
+    {
+        return fallback;
+    }
+    return settings[i].load();
+}
+
+uint32_t UIState::getSequence()
+{
+    return record.sequence;
+}
+/* ---------- UIState Class Ends ---------- */
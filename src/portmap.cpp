@@ -0,0 +1,186 @@
+#include "vex.h"
+
+// cell layout of the built-in Ports image: rows of 8, 7 and 6 tiles
+#define PORTMAP_LEFT   49
+#define PORTMAP_TOP    52
+#define PORTMAP_STEP_X 50
+#define PORTMAP_STEP_Y 54
+
+static const char* const statusColors[] =
+{
+    "#6E6E6E",      // PORT_EMPTY
+    "#2E9E44",      // PORT_OK
+    "#D03030",      // PORT_MISSING
+    "#E08A1E",      // PORT_WRONG
+    "#3070C0"       // PORT_EXTRA
+};
+
+static void cellPosition(int port, int& x, int& y)
+{
+    int row = port < 8 ? 0 : (port < 15 ? 1 : 2);
+    int column = port - (row == 0 ? 0 : (row == 1 ? 8 : 15));
+    x = PORTMAP_LEFT + column * PORTMAP_STEP_X;
+    y = PORTMAP_TOP + row * PORTMAP_STEP_Y;
+}
+
+/* ---------- PortMap Class ---------- */
+
+uint8_t PortMap::expected[PORTMAP_PORTS];
+std::atomic<uint8_t> PortMap::detected[PORTMAP_PORTS];
+uint8_t PortMap::drawn[PORTMAP_PORTS];
+uint8_t PortMap::drawnType[PORTMAP_PORTS];
+std::atomic<bool> PortMap::invalid(true);
+uint32_t PortMap::lastScan = 0;
+bool PortMap::scanned = false;
+std::atomic<uint32_t> PortMap::scans(0);
+std::atomic<uint32_t> PortMap::changes(0);
+std::atomic<uint32_t> PortMap::cellsDrawn(0);
+
+void PortMap::expect(int port, V5_DeviceType type)
+{
+    if (port >= 0 && port < PORTMAP_PORTS)
+    {
+        expected[port] = (uint8_t)type;
+    }
+}
+void PortMap::expect(motor& sensor)
+{
+    expect(sensor.index(), kDeviceTypeMotorSensor);
+}
+void PortMap::expect(inertial& sensor)
+{
+    expect(sensor.index(), kDeviceTypeImuSensor);
+}
+
+int PortMap::poll()
+{
+    uint32_t now = timer::system();
+    if (scanned && now - lastScan < PORTMAP_POLL_MS)
+    {
+        return -1;
+    }
+    int changed = 0;
+    for (int port = 0; port < PORTMAP_PORTS; port++)
+    {
+        uint8_t type = (uint8_t)device(port).type();
+        if (detected[port].exchange(type) != type && scanned)
+        {
+            changed++;
+        }
+    }
+    lastScan = now;
+    scanned = true;
+    scans.fetch_add(1);
+    changes.fetch_add(changed);
+    return changed;
+}
+
+int PortMap::draw()
+{
+    if (invalid.exchange(false))
+    {
+        memset(drawn, 0, sizeof(drawn));
+
+        // cover the placeholder art between the tiles, left of the Home button
+        Brain.Screen.setPenColor("#3C3C3C");
+        Brain.Screen.setFillColor("#3C3C3C");
+        Brain.Screen.drawRectangle(40, 44, 392, 92);
+        Brain.Screen.drawRectangle(40, 136, 292, 60);
+    }
+
+    int count = 0;
+    for (int port = 0; port < PORTMAP_PORTS; port++)
+    {
+        PortStatus status = getStatus(port);
+        uint8_t type = detected[port].load();
+        if (drawn[port] != status + 1 || drawnType[port] != type)
+        {
+            drawCell(port, status, type);
+            drawn[port] = (uint8_t)(status + 1);
+            drawnType[port] = type;
+            count++;
+        }
+    }
+    if (count)
+    {
+        Brain.Screen.setFont(mono20);
+    }
+    cellsDrawn.fetch_add(count);
+    return count;
+}
+void PortMap::drawCell(int port, PortStatus status, uint8_t type)
+{
+    int x, y;
+    cellPosition(port, x, y);
+    Brain.Screen.setPenColor(statusColors[status]);
+    Brain.Screen.setFillColor(statusColors[status]);
+    Brain.Screen.drawRectangle(x, y, PORTMAP_CELL, PORTMAP_CELL);
+
+    Brain.Screen.setFont(mono12);
+    Brain.Screen.setPenColor(white);
+    Brain.Screen.printAt(x + 3, y + 11, "%d", port + 1);
+    Brain.Screen.printAt(x + 2, y + 22, "%s", typeName(type));
+}
+
+void PortMap::invalidate()
+{
+    invalid.store(true);
+}
+
+PortStatus PortMap::getStatus(int port)
+{
+    if (port < 0 || port >= PORTMAP_PORTS)
+    {
+        return PORT_EMPTY;
+    }
+    uint8_t want = expected[port];
+    uint8_t have = detected[port].load(std::memory_order_relaxed);
+    if (want == kDeviceTypeNoSensor)
+    {
+        return have == kDeviceTypeNoSensor ? PORT_EMPTY : PORT_EXTRA;
+    }
+    if (have == kDeviceTypeNoSensor)
+    {
+        return PORT_MISSING;
+    }
+    return have == want ? PORT_OK : PORT_WRONG;
+}
+V5_DeviceType PortMap::getType(int port)
+{
+    if (port < 0 || port >= PORTMAP_PORTS)
+    {
+        return kDeviceTypeNoSensor;
+    }
+    return (V5_DeviceType)detected[port].load();
+}
+
+const char* PortMap::typeName(uint8_t type)
+{
+    switch (type)
+    {
+        case kDeviceTypeNoSensor:       return "---";
+        case kDeviceTypeMotorSensor:    return "MTR";
+        case kDeviceTypeLedSensor:      return "LED";
+        case kDeviceTypeAbsEncSensor:   return "ROT";
+        case kDeviceTypeCrMotorSensor:  return "EXP";
+        case kDeviceTypeImuSensor:      return "IMU";
+        case kDeviceTypeDistanceSensor: return "DST";
+        case kDeviceTypeRadioSensor:    return "RAD";
+        case kDeviceTypeVisionSensor:   return "VIS";
+        case kDeviceTypeAdiSensor:      return "ADI";
+        case kDeviceTypeOpticalSensor:  return "OPT";
+        case kDeviceTypeMagnetSensor:   return "MAG";
+        case kDeviceTypeGpsSensor:      return "GPS";
+        default:                        return "???";
+    }
+}
+
+PortMapStats PortMap::getStats()
+{
+    PortMapStats stats;
+    stats.scans = scans.load();
+    stats.changes = changes.load();
+    stats.cellsDrawn = cellsDrawn.load();
+    return stats;
+}
+/* ---------- PortMap Class Ends ---------- */
@@ -0,0 +1,177 @@
+#include "vex.h"
+
+/* ---------- InputRecorder Class ---------- */
+
+InputRecord InputRecorder::records[INPUT_LOG_CAPACITY];
+std::atomic<uint32_t> InputRecorder::count(0);
+std::atomic<bool> InputRecorder::recording(false);
+uint32_t InputRecorder::startTime = 0;
+uint32_t InputRecorder::samplePeriod = 50;
+InputRecorder::Watched InputRecorder::watched[INPUT_MAX_WATCHED];
+int InputRecorder::watchedCount = 0;
+task* InputRecorder::sampler = nullptr;
+
+bool InputRecorder::watch(inertial& sensor)
+{
+    if (watchedCount >= INPUT_MAX_WATCHED)
+    {
+        return false;
+    }
+    watched[watchedCount].sensor = &sensor;
+    watched[watchedCount].isMotor = false;
+    watchedCount++;
+    return true;
+}
+bool InputRecorder::watch(motor& sensor)
+{
+    if (watchedCount >= INPUT_MAX_WATCHED)
+    {
+        return false;
+    }
+    watched[watchedCount].sensor = &sensor;
+    watched[watchedCount].isMotor = true;
+    watchedCount++;
+    return true;
+}
+
+void InputRecorder::append(uint8_t type, uint8_t port, int16_t x, int16_t y, int16_t value)
+{
+    // the sampler and the menu loop both append: claim a slot first
+    uint32_t i = count.load(std::memory_order_relaxed);
+    do
+    {
+        if (i >= INPUT_LOG_CAPACITY)
+        {
+            recording.store(false);     // full: keep what we have
+            return;
+        }
+    } while (!count.compare_exchange_weak(i, i + 1, std::memory_order_relaxed));
+
+    InputRecord& record = records[i];
+    record.time = timer::system() - startTime;
+    record.type = type;
+    record.port = port;
+    record.x = x;
+    record.y = y;
+    record.value = value;
+}
+
+void InputRecorder::sample(Watched& w, bool force)
+{
+    uint8_t port = (uint8_t)w.sensor->index();
+    if (w.isMotor)
+    {
+        motor* m = static_cast<motor*>(w.sensor);
+        int16_t temperature = (int16_t)(m->temperature(celsius) * 10);
+        int16_t voltage = (int16_t)(m->voltage(voltageUnits::volt) * 1000);
+        if (force || temperature != w.last[0])
+        {
+            append(INPUT_MOTOR_TEMP, port, 0, 0, temperature);
+        }
+        if (force || voltage != w.last[1])
+        {
+            append(INPUT_MOTOR_VOLT, port, 0, 0, voltage);
+        }
+        w.last[0] = temperature;
+        w.last[1] = voltage;
+    }
+    else
+    {
+        inertial* imu = static_cast<inertial*>(w.sensor);
+        int16_t heading = (int16_t)(imu->heading(degrees) * 10);
+        if (force || heading != w.last[0])
+        {
+            append(INPUT_HEADING, port, 0, 0, heading);
+        }
+        w.last[0] = heading;
+    }
+}
+int InputRecorder::sampleTask()
+{
+    while (recording.load())
+    {
+        for (int i = 0; i < watchedCount; i++)
+        {
+            sample(watched[i], false);
+        }
+        wait(samplePeriod, msec);
+    }
+    return 0;
+}
+
+void InputRecorder::start(uint32_t periodMs)
+{
+    stop();
+    count.store(0);
+    startTime = timer::system();
+    samplePeriod = periodMs ? periodMs : 1;
+    recording.store(true);
+
+    // initial values, so a replay starts from the recorded state
+    for (int i = 0; i < watchedCount; i++)
+    {
+        sample(watched[i], true);
+    }
+    if (watchedCount > 0)
+    {
+        HeapScope scope(HEAP_TASKS);
+        sampler = new task(InputRecorder::sampleTask);
+    }
+}
+void InputRecorder::stop()
+{
+    recording.store(false);
+    if (sampler)
+    {
+        sampler->stop();
+        delete sampler;
+        sampler = nullptr;
+    }
+}
+bool InputRecorder::isRecording()
+{
+    return recording.load(std::memory_order_relaxed);
+}
+
+void InputRecorder::touch(bool pressed, int x, int y)
+{
+    if (recording.load(std::memory_order_relaxed))
+    {
+        append(pressed ? INPUT_TOUCH_PRESS : INPUT_TOUCH_RELEASE, 0, (int16_t)x, (int16_t)y, 0);
+    }
+}
+
+int InputRecorder::size()
+{
+    return (int)count.load();
+}
+const InputRecord* InputRecorder::get(int i)
+{
+    if (i < 0 || i >= size())
+    {
+        return nullptr;
+    }
+    return &records[i];
+}
+
+bool InputRecorder::save(const char* filename)
+{
+    if (!Brain.SDcard.isInserted())
+    {
+        return false;
+    }
+    InputLogHeader header;
+    header.magic = INPUT_LOG_MAGIC;
+    header.version = INPUT_LOG_VERSION;
+    header.recordSize = sizeof(InputRecord);
+    header.count = (uint32_t)size();
+
+    int32_t bytes = header.count * sizeof(InputRecord);
+    if (Brain.SDcard.savefile(filename, (uint8_t*)&header, sizeof(header)) != (int32_t)sizeof(header))
+    {
+        return false;
+    }
+    return bytes == 0 ||
+           Brain.SDcard.appendfile(filename, (uint8_t*)records, bytes) == bytes;
+}
+/* ---------- InputRecorder Class Ends ---------- */
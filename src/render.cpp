@@ -0,0 +1,1031 @@
+#include "vex.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static uint32_t* captureFrame = nullptr;
+static uint32_t* trackedFrame = nullptr;
+static RenderBuffer* recordingBuffer = nullptr;
+static std::atomic<uint32_t> screenGeneration(0);
+
+// copies a run into the capture and tracked frames, whichever are set
+static void mirrorSpan(uint32_t rgb, int x, int y, int length)
+{
+    if (y < 0 || y >= SCREEN_HEIGHT)
+    {
+        return;
+    }
+    int from = x < 0 ? 0 : x;
+    int to = x + length < SCREEN_WIDTH ? x + length : SCREEN_WIDTH;
+    if (captureFrame)
+    {
+        fillPixels(captureFrame + y * SCREEN_WIDTH + from, rgb, to - from);
+    }
+    if (trackedFrame)
+    {
+        fillPixels(trackedFrame + y * SCREEN_WIDTH + from, rgb, to - from);
+    }
+}
+
+// copies decoded pixels into the capture and tracked frames
+static void mirrorRow(const uint32_t* pixels, int x, int y, int length)
+{
+    if (y < 0 || y >= SCREEN_HEIGHT || x < 0 || x + length > SCREEN_WIDTH)
+    {
+        return;
+    }
+    if (captureFrame)
+    {
+        memcpy(captureFrame + y * SCREEN_WIDTH + x, pixels, length * sizeof(uint32_t));
+    }
+    if (trackedFrame)
+    {
+        memcpy(trackedFrame + y * SCREEN_WIDTH + x, pixels, length * sizeof(uint32_t));
+    }
+}
+
+/* ---------- Color Helpers ---------- */
+
+static int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+uint32_t parseColor(const char* hex)
+{
+    if (!hex || hex[0] != '#')
+    {
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 1; i <= 6; i++)
+    {
+        int digit = hexDigit(hex[i]);
+        if (digit < 0)
+        {
+            return 0;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+
+/* ---------- RLE Images ---------- */
+
+void fillPixels(uint32_t* pixels, uint32_t rgb, int count)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    uint32x4_t v = vdupq_n_u32(rgb);
+    for (; count >= 8; count -= 8, pixels += 8)
+    {
+        vst1q_u32(pixels, v);
+        vst1q_u32(pixels + 4, v);
+    }
+    if (count >= 4)
+    {
+        vst1q_u32(pixels, v);
+        pixels += 4;
+        count -= 4;
+    }
+#elif defined(__SSE2__)
+    __m128i v = _mm_set1_epi32((int)rgb);
+    for (; count >= 8; count -= 8, pixels += 8)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 4), v);
+    }
+    if (count >= 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), v);
+        pixels += 4;
+        count -= 4;
+    }
+#endif
+    while (count-- > 0)
+    {
+        *pixels++ = rgb;
+    }
+}
+
+// a row of the image was decoded: draw its opaque part from start to end
+typedef void (*RowSegment)(uint32_t* row, int start, int end, int y);
+
+/*  Converted images have thousands of colors, each used by several
+    short runs, so parsing "#rrggbb" once per run would cost more than
+    filling the run. Parsed colors are kept by palette index for the
+    image being decoded; another image or a collision parses again. */
+#define RENDER_COLOR_CACHE 1024
+static uint32_t colorStamp[RENDER_COLOR_CACHE];
+static int colorIndex[RENDER_COLOR_CACHE];
+static uint32_t colorValue[RENDER_COLOR_CACHE];
+static uint32_t colorImage = 0;
+
+static uint32_t cachedColor(const char* const* colors, int index)
+{
+    int slot = index & (RENDER_COLOR_CACHE - 1);
+    if (colorStamp[slot] != colorImage || colorIndex[slot] != index)
+    {
+        colorStamp[slot] = colorImage;
+        colorIndex[slot] = index;
+        colorValue[slot] = parseColor(colors[index]);
+    }
+    return colorValue[slot];
+}
+
+/*  Expands the runs a row at a time. With one row of storage (rows == 1)
+    every row is decoded over the previous one and handed to segment()
+    piece by piece, as skip runs break it; otherwise row y is at
+    pixels + y * SCREEN_WIDTH and decoding stops after `rows` rows. */
+static int expandRuns(const char* const* colors, const int* indices, const int* counts, 
+                      int runs, uint32_t* pixels, int rows, RowSegment segment)
+{
+    int x = 0, y = 0, start = 0, covered = 0;
+    colorImage++;
+    for (int i = 0; i < runs && (rows == 1 || y < rows); i++)
+    {
+        int index = indices[i];
+        int count = counts[i];
+        uint32_t pixel = index >= 0 ? cachedColor(colors, index) : 0;
+        while (count > 0 && (rows == 1 || y < rows))
+        {
+            int length = count < SCREEN_WIDTH - x ? count : SCREEN_WIDTH - x;
+            uint32_t* row = rows == 1 ? pixels : pixels + y * SCREEN_WIDTH;
+            if (index >= 0)
+            {
+                fillPixels(row + x, pixel, length);
+            }
+            else
+            {
+                if (segment && x > start)
+                {
+                    segment(row, start, x, y);
+                }
+                start = x + length;
+            }
+            x += length;
+            count -= length;
+            covered += length;
+            if (x >= SCREEN_WIDTH)
+            {
+                if (segment && start < SCREEN_WIDTH)
+                {
+                    segment(row, start, SCREEN_WIDTH, y);
+                }
+                x = start = 0;
+                y++;
+            }
+        }
+    }
+    if (segment && x > start)
+    {
+        segment(pixels, start, x, y);       // a last, partial row
+    }
+    return covered;
+}
+
+static void drawRowSegment(uint32_t* row, int start, int end, int y)
+{
+    Brain.Screen.drawImageFromBuffer(row + start, start, y, end - start, 1);
+    mirrorRow(row + start, start, y, end - start);
+}
+
+int expandImageRLE(const char* const* colors, const int* indices,
+                   const int* counts, int runs, uint32_t* frame)
+{
+    return frame ? expandRuns(colors, indices, counts, runs, frame, SCREEN_HEIGHT, nullptr) : 0;
+}
+
+void drawImageRLE(const char* const* colors, const int* indices,
+                  const int* counts, int runs)
+{
+    if (!recordingBuffer)
+    {
+        // decoded into one row, blitted once per row (or per piece
+        // between skip runs); display callbacks run one at a time
+        static uint32_t row[SCREEN_WIDTH];
+        expandRuns(colors, indices, counts, runs, row, 1, drawRowSegment);
+        return;
+    }
+
+    int x = 0, y = 0;
+    colorImage++;
+    for(int i = 0; i < runs; ++i) {
+        int index = indices[i];
+        int count = counts[i];
+        if(index >= 0) {
+            // record the run as one span per row it touches
+            uint32_t pixel = cachedColor(colors, index);
+            recordingBuffer->setPenColor(pixel);
+            while(count > 0) {
+                int length = count < SCREEN_WIDTH - x ? count : SCREEN_WIDTH - x;
+                mirrorSpan(pixel, x, y, length);
+                recordingBuffer->drawSpan(x, y, length);
+                x += length;
+                count -= length;
+                if(x >= SCREEN_WIDTH) { x = 0; y++; }
+            }
+        } else {
+            x += count;
+            while(x >= SCREEN_WIDTH) { x -= SCREEN_WIDTH; y++; }
+        }
+    }
+}
+
+void drawImageSpan(uint32_t rgb, int x, int y, int length)
+{
+    if (length <= 0)
+    {
+        return;
+    }
+    mirrorSpan(rgb, x, y, length);
+    if (recordingBuffer)
+    {
+        recordingBuffer->setPenColor(rgb);
+        recordingBuffer->drawSpan(x, y, length);
+        return;
+    }
+    Brain.Screen.setPenColor(color((int)rgb));
+    if (length == 1)
+    {
+        Brain.Screen.drawPixel(x, y);
+    }
+    else
+    {
+        Brain.Screen.drawLine(x, y, x + length - 1, y);
+    }
+}
+void drawImageBlock(uint32_t rgb, int x, int y, int width, int height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+    for (int i = 0; i < height; i++)
+    {
+        mirrorSpan(rgb, x, y + i, width);
+    }
+    if (recordingBuffer)
+    {
+        recordingBuffer->setPenColor(rgb);
+        recordingBuffer->setFillColor(rgb);
+        recordingBuffer->drawRectangle(x, y, width, height);
+        return;
+    }
+    Brain.Screen.setPenColor(color((int)rgb));
+    Brain.Screen.setFillColor(color((int)rgb));
+    Brain.Screen.drawRectangle(x, y, width, height);
+}
+
+
+/* ---------- Frame Capture ---------- */
+
+void beginCapture(uint32_t* frame)
+{
+    screenGeneration.fetch_add(1);
+    captureFrame = frame;
+    if (captureFrame)
+    {
+        memset(captureFrame, 0, FRAME_BYTES);
+    }
+    if (trackedFrame)
+    {
+        memset(trackedFrame, 0, FRAME_BYTES);   // a Display() starts on a cleared screen
+    }
+}
+uint32_t* endCapture()
+{
+    uint32_t* frame = captureFrame;
+    captureFrame = nullptr;
+    return frame;
+}
+void drawFrame(uint32_t* frame)
+{
+    if (frame)
+    {
+        screenGeneration.fetch_add(1);
+        Brain.Screen.drawImageFromBuffer(frame, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (trackedFrame && trackedFrame != frame)
+        {
+            memcpy(trackedFrame, frame, FRAME_BYTES);
+        }
+    }
+}
+void setTrackedFrame(uint32_t* frame)
+{
+    trackedFrame = frame;
+    if (trackedFrame)
+    {
+        memset(trackedFrame, 0, FRAME_BYTES);
+    }
+}
+const uint32_t* getTrackedFrame()
+{
+    return trackedFrame;
+}
+uint32_t getScreenGeneration()
+{
+    return screenGeneration.load();
+}
+
+
+/* ---------- RenderBuffer Class ---------- */
+
+#define RENDER_MAP_WIDTH  480       // coverage map: the whole physical screen
+#define RENDER_MAP_HEIGHT 272
+#define RENDER_MAP_WORDS  (RENDER_MAP_WIDTH / 32)
+#define RENDER_MAX_GROUPS 4096      // distinct pen states reordered per segment
+#define RENDER_GROUP_SLOTS (RENDER_MAX_GROUPS * 2)
+#define RENDER_MAX_COVERS 64        // opaque rectangles tracked by dropCovered()
+
+static const uint8_t RC_DROPPED = 0xFF;
+
+RenderBuffer::RenderBuffer (int capacity)
+    : count(0), textUsed(0), recording(false), hasPending(false)
+{
+    capacity = capacity < 65535 ? capacity : 65535;
+    this->commands = new (std::nothrow) RenderCommand[capacity];
+    this->order = new (std::nothrow) uint16_t[capacity];
+    this->group = new (std::nothrow) uint16_t[capacity];
+    this->coverage = new (std::nothrow) uint32_t[RENDER_MAP_WORDS * RENDER_MAP_HEIGHT];
+    this->keys = new (std::nothrow) GroupKey[RENDER_MAX_GROUPS];
+    this->slots = new (std::nothrow) uint16_t[RENDER_GROUP_SLOTS];
+    this->starts = new (std::nothrow) int[RENDER_MAX_GROUPS + 1];
+    bool ok = this->commands && this->order && this->group && this->coverage &&
+              this->keys && this->slots && this->starts;
+    if (this->slots)
+    {
+        memset(this->slots, 0, RENDER_GROUP_SLOTS * sizeof(uint16_t));
+    }
+    this->capacity = ok ? capacity : 0;
+    memset(&this->stats, 0, sizeof(this->stats));
+}
+RenderBuffer::~RenderBuffer ()
+{
+    if (recordingBuffer == this)
+    {
+        recordingBuffer = nullptr;
+    }
+    delete[] this->commands;
+    delete[] this->order;
+    delete[] this->group;
+    delete[] this->coverage;
+    delete[] this->keys;
+    delete[] this->slots;
+    delete[] this->starts;
+}
+
+void RenderBuffer::begin()
+{
+    memset(&this->stats, 0, sizeof(this->stats));
+    this->count = 0;
+    this->textUsed = 0;
+    this->pen = this->fill = RENDER_UNSET;
+    this->penWidth = this->font = (int)RENDER_UNSET;
+    this->screenPen = this->screenFill = RENDER_UNSET;
+    this->screenWidth = this->screenFont = (int)RENDER_UNSET;
+    this->originX = this->originY = 0;
+    this->batchOriginX = this->batchOriginY = 0;
+    this->hasPending = false;
+    this->recording = this->capacity > 0;
+    if (this->recording)
+    {
+        recordingBuffer = this;
+    }
+}
+RenderStats RenderBuffer::end()
+{
+    if (this->recording)
+    {
+        this->flush();
+        // leave Brain.Screen in the state the caller last asked for
+        this->applyPen(this->pen);
+        this->applyFill(this->fill);
+        this->applyWidth(this->penWidth);
+        this->applyFont(this->font);
+        this->recording = false;
+    }
+    if (recordingBuffer == this)
+    {
+        recordingBuffer = nullptr;
+    }
+    return this->stats;
+}
+bool RenderBuffer::isRecording() const
+{
+    return this->recording;
+}
+RenderStats RenderBuffer::getStats() const
+{
+    return this->stats;
+}
+
+
+// ------ recording ------
+RenderCommand* RenderBuffer::push(uint8_t op)
+{
+    if (this->count == this->capacity)
+    {
+        this->flush();          // full: draw what we have and keep going
+    }
+    RenderCommand& c = this->commands[this->count++];
+    c.op = op;
+    c.width = (uint8_t)this->penWidth;
+    c.text = 0;
+    c.pen = this->pen;
+    c.fill = this->fill;
+    this->stats.commands++;
+    return &c;
+}
+
+void RenderBuffer::setPenColor(const char* hex)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setPenColor(hex);
+        return;
+    }
+    this->setPenColor(parseColor(hex));
+}
+void RenderBuffer::setPenColor(uint32_t rgb)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setPenColor(color((int)(rgb & 0xFFFFFF)));
+        return;
+    }
+    this->pen = rgb & 0xFFFFFF;
+    this->stats.stateRecorded++;
+}
+void RenderBuffer::setFillColor(const char* hex)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setFillColor(hex);
+        return;
+    }
+    this->setFillColor(parseColor(hex));
+}
+void RenderBuffer::setFillColor(uint32_t rgb)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setFillColor(color((int)(rgb & 0xFFFFFF)));
+        return;
+    }
+    this->fill = rgb & 0xFFFFFF;
+    this->stats.stateRecorded++;
+}
+void RenderBuffer::setTransparentFill()
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setFillColor(transparent);
+        return;
+    }
+    this->fill = RENDER_TRANSPARENT;
+    this->stats.stateRecorded++;
+}
+void RenderBuffer::setPenWidth(uint32_t width)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setPenWidth(width);
+        return;
+    }
+    this->penWidth = width < 1 ? 1 : width > 255 ? 255 : (int)width;
+    this->stats.stateRecorded++;
+}
+void RenderBuffer::setFont(fontType f)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setFont(f);
+        return;
+    }
+    this->font = (int)f;
+    this->stats.stateRecorded++;
+}
+void RenderBuffer::setOrigin(int x, int y)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.setOrigin(x, y);
+        return;
+    }
+    RenderCommand* c = this->push(RC_ORIGIN);
+    c->x = x;
+    c->y = y;
+    c->w = c->h = 0;
+    this->originX = x;
+    this->originY = y;
+}
+
+void RenderBuffer::drawPixel(int x, int y)
+{
+    this->drawSpan(x, y, 1);
+}
+void RenderBuffer::drawSpan(int x, int y, int length)
+{
+    if (length <= 0)
+    {
+        return;
+    }
+    if (!this->recording)
+    {
+        if (length == 1)
+        {
+            Brain.Screen.drawPixel(x, y);
+        }
+        else
+        {
+            Brain.Screen.drawLine(x, y, x + length - 1, y);
+        }
+        return;
+    }
+    RenderCommand* c = this->push(RC_SPAN);
+    c->x = x;
+    c->y = y;
+    c->w = length;
+    c->h = 1;
+}
+void RenderBuffer::drawLine(int x1, int y1, int x2, int y2)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.drawLine(x1, y1, x2, y2);
+        return;
+    }
+    RenderCommand* c = this->push(RC_LINE);
+    c->x = x1;
+    c->y = y1;
+    c->w = x2;
+    c->h = y2;
+}
+void RenderBuffer::drawRectangle(int x, int y, int width, int height)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.drawRectangle(x, y, width, height);
+        return;
+    }
+    RenderCommand* c = this->push(RC_RECT);
+    c->x = x;
+    c->y = y;
+    c->w = width;
+    c->h = height;
+}
+void RenderBuffer::drawCircle(int x, int y, int radius)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.drawCircle(x, y, radius);
+        return;
+    }
+    RenderCommand* c = this->push(RC_CIRCLE);
+    c->x = x;
+    c->y = y;
+    c->w = radius;
+    c->h = 0;
+}
+void RenderBuffer::printAt(int x, int y, const char* format, ...)
+{
+    char line[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (!this->recording)
+    {
+        Brain.Screen.printAt(x, y, "%s", line);
+        return;
+    }
+    int length = (int)strlen(line) + 1;
+    if (this->textUsed + length > RENDER_TEXT_POOL)
+    {
+        this->flush();
+    }
+    RenderCommand* c = this->push(RC_TEXT);
+    c->x = x;
+    c->y = y;
+    c->w = length - 1;
+    c->h = 0;
+    c->width = this->font == (int)RENDER_UNSET ? 0 : this->font + 1;
+    c->text = this->textUsed;
+    memcpy(this->text + this->textUsed, line, length);
+    this->textUsed += length;
+}
+void RenderBuffer::clearScreen(uint32_t rgb)
+{
+    if (!this->recording)
+    {
+        Brain.Screen.clearScreen(color((int)(rgb & 0xFFFFFF)));
+        return;
+    }
+    RenderCommand* c = this->push(RC_CLEAR);
+    c->x = c->y = c->w = c->h = 0;
+    c->fill = rgb & 0xFFFFFF;
+}
+
+
+// ------ optimizing ------
+static int fontHeight(int font)
+{
+    switch (font)
+    {
+        case mono12: return 12;
+        case mono15: return 15;
+        case mono20: case prop20: return 20;
+        case mono30: case prop30: return 30;
+        case mono40: case prop40: return 40;
+        default: return 60;
+    }
+}
+
+// pixels a command may touch, relative to its origin (conservative)
+RenderBuffer::Box RenderBuffer::bounds(const RenderCommand& c) const
+{
+    Box b;
+    int pad = c.width == 0 ? 8 : c.width / 2 + 1;
+    switch (c.op)
+    {
+        case RC_SPAN:
+            b.x1 = c.x; b.x2 = c.x + c.w - 1; b.y1 = b.y2 = c.y;
+            break;
+        case RC_LINE:
+            b.x1 = (c.x < c.w ? c.x : c.w) - pad; b.x2 = (c.x > c.w ? c.x : c.w) + pad;
+            b.y1 = (c.y < c.h ? c.y : c.h) - pad; b.y2 = (c.y > c.h ? c.y : c.h) + pad;
+            break;
+        case RC_RECT:
+            b.x1 = c.x - pad; b.x2 = c.x + c.w + pad;
+            b.y1 = c.y - pad; b.y2 = c.y + c.h + pad;
+            break;
+        case RC_CIRCLE:
+            b.x1 = c.x - c.w - pad; b.x2 = c.x + c.w + pad;
+            b.y1 = c.y - c.w - pad; b.y2 = c.y + c.w + pad;
+            break;
+        case RC_TEXT:
+        {
+            int h = fontHeight(c.width - 1);
+            b.x1 = c.x - 2; b.x2 = c.x + (c.w + 1) * h;
+            b.y1 = c.y - h; b.y2 = c.y + h / 2;
+            break;
+        }
+        default:            // clear, origin: everything
+            b.x1 = b.y1 = -32768; b.x2 = b.y2 = 32767;
+            break;
+    }
+    return b;
+}
+
+// whether every pixel inside the returned box is overwritten by c
+bool RenderBuffer::covers(const RenderCommand& c, Box& box) const
+{
+    if (c.op == RC_CLEAR)
+    {
+        box.x1 = box.y1 = -32768;
+        box.x2 = box.y2 = 32767;
+        return true;
+    }
+    if (c.op == RC_RECT && c.w > 0 && c.h > 0 &&
+        !(c.pen & (RENDER_TRANSPARENT | RENDER_UNSET)) &&
+        !(c.fill & (RENDER_TRANSPARENT | RENDER_UNSET)))
+    {
+        box.x1 = c.x; box.x2 = c.x + c.w - 1;
+        box.y1 = c.y; box.y2 = c.y + c.h - 1;
+        return true;
+    }
+    return false;
+}
+
+bool RenderBuffer::testAndMark(const Box& b)
+{
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int y = b.y1; y <= b.y2; y++)
+        {
+            uint32_t* row = this->coverage + y * RENDER_MAP_WORDS;
+            for (int w = b.x1 >> 5; w <= b.x2 >> 5; w++)
+            {
+                int lo = (b.x1 > w * 32 ? b.x1 : w * 32) - w * 32;
+                int hi = (b.x2 < w * 32 + 31 ? b.x2 : w * 32 + 31) - w * 32;
+                uint32_t mask = (hi == 31 ? 0xFFFFFFFFu : (1u << (hi + 1)) - 1) & ~((1u << lo) - 1);
+                if (pass == 0 && (row[w] & mask))
+                {
+                    return false;
+                }
+                row[w] |= pass ? mask : 0;
+            }
+        }
+    }
+    return true;
+}
+
+void RenderBuffer::dropCovered()
+{
+    Box covers[RENDER_MAX_COVERS];
+    int coverCount = 0;
+    for (int i = this->count - 1; i >= 0; i--)
+    {
+        RenderCommand& c = this->commands[i];
+        if (c.op == RC_ORIGIN)
+        {
+            coverCount = 0;     // earlier commands use other coordinates
+            continue;
+        }
+        Box b = this->bounds(c);
+        for (int k = 0; k < coverCount; k++)
+        {
+            if (b.x1 >= covers[k].x1 && b.x2 <= covers[k].x2 &&
+                b.y1 >= covers[k].y1 && b.y2 <= covers[k].y2)
+            {
+                c.op = RC_DROPPED;
+                this->stats.dropped++;
+                break;
+            }
+        }
+        Box cover;
+        if (c.op != RC_DROPPED && coverCount < RENDER_MAX_COVERS && this->covers(c, cover))
+        {
+            covers[coverCount++] = cover;
+        }
+    }
+}
+
+// draw commands [begin, end), none of which overlap, grouped by pen state
+void RenderBuffer::emitSegment(int begin, int end)
+{
+    int keyCount = 0;
+    bool grouped = true;
+    for (int i = begin; i < end; i++)
+    {
+        const RenderCommand& c = this->commands[i];
+        if (c.op == RC_DROPPED)
+        {
+            continue;
+        }
+        GroupKey key;
+        key.kind = c.op == RC_CIRCLE ? (int)RC_RECT : c.op;    // circles batch with rectangles
+        key.pen = c.pen;
+        key.fill = c.op == RC_RECT || c.op == RC_CIRCLE || c.op == RC_TEXT ? c.fill : 0;
+        key.extra = c.op == RC_SPAN ? 1 : c.width;
+
+        uint32_t hash = (key.pen * 2654435761u) ^ (key.fill * 40503u) ^ (key.extra << 20) ^ key.kind;
+        int slot = (hash ^ (hash >> 15)) & (RENDER_GROUP_SLOTS - 1);
+        int g = -1;
+        while (this->slots[slot])
+        {
+            const GroupKey& k = this->keys[this->slots[slot] - 1];
+            if (k.kind == key.kind && k.pen == key.pen && k.fill == key.fill && k.extra == key.extra)
+            {
+                g = this->slots[slot] - 1;
+                break;
+            }
+            slot = (slot + 1) & (RENDER_GROUP_SLOTS - 1);
+        }
+        if (g < 0)
+        {
+            if (keyCount == RENDER_MAX_GROUPS)
+            {
+                grouped = false;
+                break;
+            }
+            g = keyCount++;
+            key.slot = slot;
+            this->keys[g] = key;
+            this->slots[slot] = g + 1;
+        }
+        this->group[i] = g;
+    }
+    for (int g = 0; g < keyCount; g++)
+    {
+        this->slots[this->keys[g].slot] = 0;
+    }
+
+    if (!grouped)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            this->draw(this->commands[i]);
+        }
+        return;
+    }
+
+    // stable counting sort by group, first-used state first
+    int* start = this->starts;
+    memset(start, 0, (keyCount + 1) * sizeof(int));
+    for (int i = begin; i < end; i++)
+    {
+        if (this->commands[i].op != RC_DROPPED)
+        {
+            start[this->group[i] + 1]++;
+        }
+    }
+    for (int g = 0; g < keyCount; g++)
+    {
+        start[g + 1] += start[g];
+    }
+    int n = start[keyCount];
+    for (int i = begin; i < end; i++)
+    {
+        if (this->commands[i].op != RC_DROPPED)
+        {
+            this->order[begin + start[this->group[i]]++] = i;
+        }
+    }
+    for (int k = 0; k < n; k++)
+    {
+        this->draw(this->commands[this->order[begin + k]]);
+    }
+}
+
+void RenderBuffer::flush()
+{
+    this->dropCovered();
+
+    memset(this->coverage, 0, RENDER_MAP_WORDS * RENDER_MAP_HEIGHT * sizeof(uint32_t));
+    int ox = this->batchOriginX, oy = this->batchOriginY;
+    int segment = 0;
+    for (int i = 0; i < this->count; i++)
+    {
+        const RenderCommand& c = this->commands[i];
+        if (c.op == RC_DROPPED)
+        {
+            continue;
+        }
+        bool barrier = c.op == RC_ORIGIN || c.op == RC_CLEAR || (c.pen & RENDER_UNSET) ||
+                       ((c.op == RC_RECT || c.op == RC_CIRCLE || c.op == RC_TEXT) && (c.fill & RENDER_UNSET));
+        Box b = this->bounds(c);
+        b.x1 += ox; b.x2 += ox; b.y1 += oy; b.y2 += oy;
+        if (b.x1 < 0 || b.y1 < 0 || b.x2 >= RENDER_MAP_WIDTH || b.y2 >= RENDER_MAP_HEIGHT)
+        {
+            barrier = true;     // partly off the map: cannot prove it is disjoint
+        }
+        if (!barrier && this->testAndMark(b))
+        {
+            continue;           // disjoint from the segment so far
+        }
+
+        this->emitSegment(segment, i);
+        memset(this->coverage, 0, RENDER_MAP_WORDS * RENDER_MAP_HEIGHT * sizeof(uint32_t));
+        if (barrier)
+        {
+            this->draw(c);
+            segment = i + 1;
+            if (c.op == RC_ORIGIN)
+            {
+                ox = c.x;
+                oy = c.y;
+            }
+        }
+        else
+        {
+            this->testAndMark(b);
+            segment = i;
+        }
+    }
+    this->emitSegment(segment, this->count);
+    if (this->hasPending)
+    {
+        this->drawNow(this->pending);
+        this->hasPending = false;
+    }
+
+    this->count = 0;
+    this->textUsed = 0;
+    this->batchOriginX = this->originX;
+    this->batchOriginY = this->originY;
+}
+
+
+// ------ replay ------
+void RenderBuffer::applyPen(uint32_t value)
+{
+    if (value != this->screenPen && !(value & RENDER_UNSET))
+    {
+        this->screenPen = value;
+        this->stats.stateIssued++;
+        if (value & RENDER_TRANSPARENT)
+        {
+            Brain.Screen.setPenColor(transparent);
+        }
+        else
+        {
+            Brain.Screen.setPenColor(color((int)value));
+        }
+    }
+}
+void RenderBuffer::applyFill(uint32_t value)
+{
+    if (value != this->screenFill && !(value & RENDER_UNSET))
+    {
+        this->screenFill = value;
+        this->stats.stateIssued++;
+        if (value & RENDER_TRANSPARENT)
+        {
+            Brain.Screen.setFillColor(transparent);
+        }
+        else
+        {
+            Brain.Screen.setFillColor(color((int)value));
+        }
+    }
+}
+void RenderBuffer::applyWidth(int value)
+{
+    if (value != this->screenWidth && value != (int)RENDER_UNSET && value != 0)
+    {
+        this->screenWidth = value;
+        this->stats.stateIssued++;
+        Brain.Screen.setPenWidth(value);
+    }
+}
+void RenderBuffer::applyFont(int value)
+{
+    if (value != this->screenFont && value != (int)RENDER_UNSET)
+    {
+        this->screenFont = value;
+        this->stats.stateIssued++;
+        Brain.Screen.setFont((fontType)value);
+    }
+}
+
+void RenderBuffer::draw(const RenderCommand& c)
+{
+    if (this->hasPending)
+    {
+        if (c.op == RC_SPAN && c.pen == this->pending.pen && c.y == this->pending.y &&
+            this->pending.x + this->pending.w == c.x)
+        {
+            this->pending.w += c.w;
+            this->stats.merged++;
+            return;
+        }
+        this->drawNow(this->pending);
+        this->hasPending = false;
+    }
+    if (c.op == RC_SPAN)
+    {
+        this->pending = c;
+        this->hasPending = true;
+        return;
+    }
+    this->drawNow(c);
+}
+void RenderBuffer::drawNow(const RenderCommand& c)
+{
+    switch (c.op)
+    {
+        case RC_SPAN:
+            this->applyPen(c.pen);
+            if (c.w == 1)
+            {
+                Brain.Screen.drawPixel(c.x, c.y);
+            }
+            else
+            {
+                this->applyWidth(1);
+                Brain.Screen.drawLine(c.x, c.y, c.x + c.w - 1, c.y);
+            }
+            break;
+        case RC_LINE:
+            this->applyPen(c.pen);
+            this->applyWidth(c.width);
+            Brain.Screen.drawLine(c.x, c.y, c.w, c.h);
+            break;
+        case RC_RECT:
+            this->applyPen(c.pen);
+            this->applyFill(c.fill);
+            this->applyWidth(c.width);
+            Brain.Screen.drawRectangle(c.x, c.y, c.w, c.h);
+            break;
+        case RC_CIRCLE:
+            this->applyPen(c.pen);
+            this->applyFill(c.fill);
+            this->applyWidth(c.width);
+            Brain.Screen.drawCircle(c.x, c.y, c.w);
+            break;
+        case RC_TEXT:
+            this->applyPen(c.pen);
+            this->applyFill(c.fill);
+            this->applyFont(c.width ? c.width - 1 : (int)RENDER_UNSET);
+            Brain.Screen.printAt(c.x, c.y, "%s", this->text + c.text);
+            break;
+        case RC_CLEAR:
+            Brain.Screen.clearScreen(color((int)c.fill));
+            break;
+        case RC_ORIGIN:
+            Brain.Screen.setOrigin(c.x, c.y);
+            break;
+        default:
+            return;
+    }
+    this->stats.drawCalls++;
+}
+/* ---------- RenderBuffer Class Ends ---------- */
@@ -0,0 +1,144 @@
+#include "vex.h"
+
+#define SCREENSHOT_SLICE_PIXELS (SCREENSHOT_SLICE_ROWS * SCREEN_WIDTH)
+
+/* ---------- Screenshot Class ---------- */
+
+uint32_t* Screenshot::tracked = nullptr;
+uint32_t* Screenshot::pending = nullptr;
+char Screenshot::filename[32];
+FrameSource Screenshot::source = nullptr;
+std::atomic<bool> Screenshot::busy(false);
+uint32_t Screenshot::startTime = 0;
+std::atomic<uint32_t> Screenshot::taken(0);
+std::atomic<uint32_t> Screenshot::written(0);
+std::atomic<uint32_t> Screenshot::failed(0);
+std::atomic<uint32_t> Screenshot::lastBytes(0);
+std::atomic<uint32_t> Screenshot::lastMs(0);
+task* Screenshot::encoder = nullptr;
+
+bool Screenshot::track(bool enable)
+{
+    if (enable && !tracked)
+    {
+        HeapScope scope(HEAP_RENDER);
+        tracked = new (std::nothrow) uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+        setTrackedFrame(tracked);
+        return tracked != nullptr;
+    }
+    if (!enable && tracked)
+    {
+        setTrackedFrame(nullptr);
+        delete[] tracked;
+        tracked = nullptr;
+    }
+    return true;
+}
+bool Screenshot::isTracking()
+{
+    return tracked != nullptr;
+}
+
+void Screenshot::setSource(FrameSource frameSource)
+{
+    source = frameSource;
+}
+bool Screenshot::trackedSource(uint32_t* frame)
+{
+    const uint32_t* current = getTrackedFrame();
+    if (!current)
+    {
+        return false;
+    }
+    memcpy(frame, current, FRAME_BYTES);
+    return true;
+}
+
+bool Screenshot::take(const char* file)
+{
+    bool idle = false;
+    if (!file || !Brain.SDcard.isInserted() || !busy.compare_exchange_strong(idle, true))
+    {
+        return false;
+    }
+    if (encoder)
+    {
+        delete encoder;     // the previous screenshot's task has returned
+        encoder = nullptr;
+    }
+
+    {
+        HeapScope scope(HEAP_ASSETS);
+        pending = new (std::nothrow) uint32_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+    }
+    if (!pending || !(source ? source : trackedSource)(pending))
+    {
+        delete[] pending;
+        pending = nullptr;
+        busy.store(false);
+        return false;
+    }
+    strncpy(filename, file, sizeof(filename) - 1);
+    filename[sizeof(filename) - 1] = 0;
+    startTime = timer::system();
+    taken.fetch_add(1);
+    HeapScope scope(HEAP_TASKS);
+    encoder = new task(Screenshot::encodeTask, SCREENSHOT_PRIORITY);
+    return true;
+}
+bool Screenshot::isBusy()
+{
+    return busy.load();
+}
+
+int Screenshot::encodeTask()
+{
+    const int total = SCREEN_WIDTH * SCREEN_HEIGHT;
+
+    // first pass: the header needs the number of run words
+    uint32_t words = 0;
+    for (int i = 0; i < total; i += SCREENSHOT_SLICE_PIXELS)
+    {
+        int count = total - i < SCREENSHOT_SLICE_PIXELS ? total - i : SCREENSHOT_SLICE_PIXELS;
+        words += AssetWriter::countRuns(pending + i, count);
+        wait(SCREENSHOT_SLICE_MS, msec);
+    }
+
+    // second pass: the same slices, encoded and written
+    AssetWriter writer;
+    bool ok = writer.open(filename, SCREEN_WIDTH, SCREEN_HEIGHT, words);
+    for (int i = 0; ok && i < total; i += SCREENSHOT_SLICE_PIXELS)
+    {
+        int count = total - i < SCREENSHOT_SLICE_PIXELS ? total - i : SCREENSHOT_SLICE_PIXELS;
+        ok = writer.write(pending + i, count);
+        wait(SCREENSHOT_SLICE_MS, msec);
+    }
+    ok = writer.close() && ok;
+
+    if (ok)
+    {
+        written.fetch_add(1);
+        lastBytes.store(sizeof(AssetHeader) + words * 4);
+        lastMs.store(timer::system() - startTime);
+    }
+    else
+    {
+        failed.fetch_add(1);
+    }
+    delete[] pending;
+    pending = nullptr;
+    busy.store(false);
+    return 0;
+}
+
+ScreenshotStats Screenshot::getStats()
+{
+    ScreenshotStats stats;
+    stats.taken = taken.load();
+    stats.written = written.load();
+    stats.failed = failed.load();
+    stats.lastBytes = lastBytes.load();
+    stats.lastMs = lastMs.load();
+    return stats;
+}
+/* ---------- Screenshot Class Ends ---------- */
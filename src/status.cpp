@@ -0,0 +1,161 @@
+#include "vex.h"
+
+/* ---------- StatusChannel Class ---------- */
+
+StatusChannel::StatusChannel (const char* initial)
+    : sequence(0), pendingState(PENDING_EMPTY), historyCount(0), historyEnabled(false)
+{
+    pack(this->words, initial);
+    pack(this->pending, "");
+}
+
+void StatusChannel::pack(std::atomic<uint32_t>* dst, const char* text)
+{
+    bool ended = false;
+    for (int w = 0; w < WORDS; w++)
+    {
+        uint32_t word = 0;
+        for (int b = 0; b < 4; b++)
+        {
+            char c = 0;
+            if (!ended && !(w == WORDS - 1 && b == 3))
+            {
+                c = *text;
+                ended = (c == 0);
+                if (!ended)
+                {
+                    text++;
+                }
+            }
+            word |= (uint32_t)(uint8_t)c << (8 * b);
+        }
+        dst[w].store(word, std::memory_order_relaxed);
+    }
+}
+void StatusChannel::unpack(char* dst, const std::atomic<uint32_t>* src)
+{
+    for (int w = 0; w < WORDS; w++)
+    {
+        uint32_t word = src[w].load(std::memory_order_relaxed);
+        for (int b = 0; b < 4; b++)
+        {
+            dst[w * 4 + b] = (char)(word >> (8 * b));
+        }
+    }
+}
+
+bool StatusChannel::claim(uint32_t& seq)
+{
+    seq = sequence.load();
+    while (!(seq & 1))
+    {
+        if (sequence.compare_exchange_weak(seq, seq + 1))
+        {
+            std::atomic_thread_fence(std::memory_order_release);
+            return true;
+        }
+    }
+    return false;       // another writer is in; never wait for it
+}
+void StatusChannel::publish(const char* text)
+{
+    pack(this->words, text);
+    if (historyEnabled.load(std::memory_order_relaxed))
+    {
+        uint32_t n = historyCount.load(std::memory_order_relaxed);
+        Slot& slot = history[n % STATUS_HISTORY_LENGTH];
+        slot.time.store(timer::system(), std::memory_order_relaxed);
+        pack(slot.words, text);
+        historyCount.store(n + 1, std::memory_order_relaxed);
+    }
+}
+
+void StatusChannel::set(const char* text)
+{
+    uint32_t seq;
+    if (claim(seq))
+    {
+        publish(text);
+        sequence.store(seq + 2);
+    }
+    else
+    {
+        // newest wins: leave the text for whichever writer holds the channel,
+        // replacing one left before; if a third writer is filling the mailbox
+        // right now, this text is dropped
+        uint32_t state = PENDING_EMPTY;
+        if (pendingState.compare_exchange_strong(state, PENDING_WRITING) ||
+            (state == PENDING_FULL && pendingState.compare_exchange_strong(state, PENDING_WRITING)))
+        {
+            pack(this->pending, text);
+            pendingState.store(PENDING_FULL);
+        }
+    }
+
+    // every writer empties the mailbox on the way out, so a text left while
+    // it held the channel is published by it or by the writer holding it now
+    while (pendingState.load() == PENDING_FULL && claim(seq))
+    {
+        uint32_t state = PENDING_FULL;
+        if (pendingState.compare_exchange_strong(state, PENDING_WRITING))
+        {
+            char latest[STATUS_LENGTH];
+            unpack(latest, this->pending);
+            pendingState.store(PENDING_EMPTY);
+            publish(latest);
+        }
+        sequence.store(seq + 2);
+    }
+}
+
+void StatusChannel::get(char* out, int size) const
+{
+    char text[STATUS_LENGTH];
+    uint32_t before, after;
+    do
+    {
+        before = sequence.load(std::memory_order_acquire);
+        unpack(text, this->words);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    if (size > 0)
+    {
+        strncpy(out, text, size - 1);
+        out[size - 1] = 0;
+    }
+}
+
+void StatusChannel::setHistoryEnabled(bool enable)
+{
+    historyEnabled.store(enable);
+}
+
+int StatusChannel::getHistory(StatusEntry* out, int max) const
+{
+    int copied;
+    uint32_t before, after;
+    do
+    {
+        before = sequence.load(std::memory_order_acquire);
+        uint32_t n = historyCount.load(std::memory_order_relaxed);
+        uint32_t first = n > STATUS_HISTORY_LENGTH ? n - STATUS_HISTORY_LENGTH : 0;
+        if (n - first > (uint32_t)max)
+        {
+            first = n - max;
+        }
+        copied = 0;
+        for (uint32_t i = first; i < n; i++)
+        {
+            const Slot& slot = history[i % STATUS_HISTORY_LENGTH];
+            out[copied].time = slot.time.load(std::memory_order_relaxed);
+            unpack(out[copied].text, slot.words);
+            copied++;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    return copied;
+}
+/* ---------- StatusChannel Class Ends ---------- */
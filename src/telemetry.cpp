@@ -0,0 +1,252 @@
+#include "vex.h"
+
+#define TELEMETRY_RING_MASK (TELEMETRY_RING_RECORDS - 1)
+
+/* ---------- Telemetry Class ---------- */
+
+Telemetry::Slot Telemetry::ring[TELEMETRY_RING_RECORDS];
+std::atomic<uint32_t> Telemetry::head(0);
+uint32_t Telemetry::tail = 0;
+uint8_t Telemetry::block[TELEMETRY_BLOCK_BYTES];
+int Telemetry::blockUsed = 0;
+uint32_t Telemetry::blockStarted = 0;
+char Telemetry::filename[32];
+uint32_t Telemetry::startTime = 0;
+uint32_t Telemetry::samplePeriod = 50;
+Telemetry::Watched Telemetry::watched[TELEMETRY_MAX_WATCHED];
+int Telemetry::watchedCount = 0;
+std::atomic<bool> Telemetry::running(false);
+std::atomic<uint32_t> Telemetry::logged(0);
+std::atomic<uint32_t> Telemetry::dropped(0);
+std::atomic<uint32_t> Telemetry::written(0);
+std::atomic<uint32_t> Telemetry::lost(0);
+std::atomic<uint32_t> Telemetry::blocks(0);
+task* Telemetry::sampler = nullptr;
+task* Telemetry::flusher = nullptr;
+
+bool Telemetry::watch(motor& sensor)
+{
+    if (watchedCount >= TELEMETRY_MAX_WATCHED)
+    {
+        return false;
+    }
+    watched[watchedCount].sensor = &sensor;
+    watched[watchedCount].isMotor = true;
+    watchedCount++;
+    return true;
+}
+bool Telemetry::watch(inertial& sensor)
+{
+    if (watchedCount >= TELEMETRY_MAX_WATCHED)
+    {
+        return false;
+    }
+    watched[watchedCount].sensor = &sensor;
+    watched[watchedCount].isMotor = false;
+    watchedCount++;
+    return true;
+}
+
+bool Telemetry::start(const char* file, uint32_t periodMs)
+{
+    stop();
+    if (!file || !Brain.SDcard.isInserted())
+    {
+        return false;
+    }
+    strncpy(filename, file, sizeof(filename) - 1);
+    filename[sizeof(filename) - 1] = 0;
+    startTime = timer::system();
+    samplePeriod = periodMs ? periodMs : 1;
+
+    TelemetryHeader header;
+    header.magic = TELEMETRY_MAGIC;
+    header.version = TELEMETRY_VERSION;
+    header.recordSize = sizeof(TelemetryRecord);
+    header.startTime = startTime;
+    if (Brain.SDcard.savefile(filename, (uint8_t*)&header, sizeof(header)) != (int32_t)sizeof(header))
+    {
+        return false;
+    }
+
+    // slot i is free for ring position i
+    for (uint32_t i = 0; i < TELEMETRY_RING_RECORDS; i++)
+    {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    head.store(0);
+    tail = 0;
+    blockUsed = 0;
+    logged.store(0);
+    dropped.store(0);
+    written.store(0);
+    lost.store(0);
+    blocks.store(0);
+
+    running.store(true);
+    HeapScope scope(HEAP_TASKS);
+    flusher = new task(Telemetry::flushTask, TELEMETRY_FLUSH_PRIORITY);
+    if (watchedCount > 0)
+    {
+        sampler = new task(Telemetry::sampleTask);
+    }
+    return true;
+}
+void Telemetry::stop()
+{
+    running.store(false);
+    if (sampler)
+    {
+        sampler->stop();
+        delete sampler;
+        sampler = nullptr;
+    }
+    if (flusher)
+    {
+        flusher->stop();
+        delete flusher;
+        flusher = nullptr;
+
+        // the flusher is gone: write the rest from here
+        drain();
+        if (blockUsed)
+        {
+            writeBlock();
+        }
+    }
+}
+bool Telemetry::isRunning()
+{
+    return running.load(std::memory_order_relaxed);
+}
+
+bool Telemetry::log(uint8_t type, uint8_t port, int16_t value)
+{
+    if (!running.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    // claim a position whose slot the flusher has already emptied
+    uint32_t position = head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;)
+    {
+        slot = &ring[position & TELEMETRY_RING_MASK];
+        int32_t lag = (int32_t)(slot->sequence.load(std::memory_order_acquire) - position);
+        if (lag == 0)
+        {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);     // full
+            return false;
+        }
+        else
+        {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record.time = timer::system() - startTime;
+    slot->record.type = type;
+    slot->record.port = port;
+    slot->record.value = value;
+    slot->sequence.store(position + 1, std::memory_order_release);      // publish
+    logged.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void Telemetry::drain()
+{
+    for (;;)
+    {
+        Slot& slot = ring[tail & TELEMETRY_RING_MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+        {
+            return;         // empty, or the next record is still being written
+        }
+        if (blockUsed == 0)
+        {
+            blockStarted = timer::system();
+        }
+        memcpy(block + blockUsed, &slot.record, sizeof(TelemetryRecord));
+        blockUsed += sizeof(TelemetryRecord);
+
+        // hand the slot back for the position one lap later
+        slot.sequence.store(tail + TELEMETRY_RING_RECORDS, std::memory_order_release);
+        tail++;
+
+        if (blockUsed + (int)sizeof(TelemetryRecord) > TELEMETRY_BLOCK_BYTES)
+        {
+            writeBlock();
+        }
+    }
+}
+void Telemetry::writeBlock()
+{
+    uint32_t records = blockUsed / sizeof(TelemetryRecord);
+    if (Brain.SDcard.appendfile(filename, block, blockUsed) == blockUsed)
+    {
+        written.fetch_add(records, std::memory_order_relaxed);
+    }
+    else
+    {
+        lost.fetch_add(records, std::memory_order_relaxed);
+    }
+    blocks.fetch_add(1, std::memory_order_relaxed);
+    blockUsed = 0;
+}
+
+int Telemetry::sampleTask()
+{
+    while (running.load())
+    {
+        for (int i = 0; i < watchedCount; i++)
+        {
+            uint8_t port = (uint8_t)watched[i].sensor->index();
+            if (watched[i].isMotor)
+            {
+                motor* m = static_cast<motor*>(watched[i].sensor);
+                log(TELEMETRY_MOTOR_TEMP, port, (int16_t)(m->temperature(celsius) * 10));
+                log(TELEMETRY_MOTOR_VOLT, port, (int16_t)(m->voltage(voltageUnits::volt) * 1000));
+            }
+            else
+            {
+                inertial* imu = static_cast<inertial*>(watched[i].sensor);
+                log(TELEMETRY_HEADING, port, (int16_t)(imu->heading(degrees) * 10));
+            }
+        }
+        wait(samplePeriod, msec);
+    }
+    return 0;
+}
+int Telemetry::flushTask()
+{
+    while (running.load())
+    {
+        drain();
+        if (blockUsed && timer::system() - blockStarted >= TELEMETRY_FLUSH_MS)
+        {
+            writeBlock();
+        }
+        wait(TELEMETRY_DRAIN_MS, msec);
+    }
+    return 0;
+}
+
+TelemetryStats Telemetry::getStats()
+{
+    TelemetryStats stats;
+    stats.logged = logged.load();
+    stats.dropped = dropped.load();
+    stats.written = written.load();
+    stats.lost = lost.load();
+    stats.blocks = blocks.load();
+    return stats;
+}
+/* ---------- Telemetry Class Ends ---------- */
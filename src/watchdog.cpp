@@ -0,0 +1,113 @@
+#include "vex.h"
+
+#define WATCHDOG_READ_TRIES 4
+
+/* ---------- Watchdog Class ---------- */
+
+std::atomic<bool> Watchdog::enabled(true);
+std::atomic<uint32_t> Watchdog::total(0);
+std::atomic<uint32_t> Watchdog::next(0);
+Watchdog::Slot Watchdog::log[WATCHDOG_LOG_SIZE];
+
+void Watchdog::setEnabled(bool enable)
+{
+    enabled.store(enable);
+}
+bool Watchdog::isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t Watchdog::begin()
+{
+    if (!enabled.load(std::memory_order_relaxed))
+    {
+        return 0;
+    }
+    uint32_t t = (uint32_t)timer::systemHighResolution();
+    return t ? t : 1;       // 0 means "not timing"
+}
+
+bool Watchdog::end(const void* key, const char* name, CallbackKind callback,
+                   uint32_t start, uint32_t budget)
+{
+    if (!start || !budget)
+    {
+        return false;
+    }
+    uint32_t elapsed = (uint32_t)timer::systemHighResolution() - start;
+    if (elapsed <= budget)
+    {
+        return false;
+    }
+
+    // the main loop and update tasks may both overrun: claim a slot first
+    uint32_t number = next.fetch_add(1);
+    Slot& slot = log[number % WATCHDOG_LOG_SIZE];
+    slot.sequence.store(0, std::memory_order_relaxed);     // being written
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Overrun& entry = slot.record;
+    entry.key = key;
+    entry.name = name;
+    entry.callback = (uint8_t)callback;
+    entry.elapsed = elapsed;
+    entry.budget = budget;
+    entry.time = timer::system();
+    slot.sequence.store(number + 1, std::memory_order_release);    // publish
+    total.fetch_add(1);
+    return true;
+}
+
+uint32_t Watchdog::overruns()
+{
+    return total.load();
+}
+int Watchdog::recent(Overrun* out, int max)
+{
+    uint32_t last = next.load();
+    uint32_t stored = total.load();
+    int n = 0;
+    for (int i = 0; n < max && i < WATCHDOG_LOG_SIZE && (uint32_t)i < stored; i++)
+    {
+        // copy the slot until it holds this overrun, complete, before and after
+        uint32_t number = last - 1 - i;
+        const Slot& slot = log[number % WATCHDOG_LOG_SIZE];
+        bool copied = false;
+        for (int tries = 0; tries < WATCHDOG_READ_TRIES && !copied; tries++)
+        {
+            uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            out[n] = slot.record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t after = slot.sequence.load(std::memory_order_relaxed);
+            copied = before == number + 1 && after == before;
+        }
+        if (copied)
+        {
+            n++;        // otherwise still being written, or already replaced
+        }
+    }
+    return n;
+}
+
+const char* Watchdog::callbackName(uint8_t callback)
+{
+    switch (callback)
+    {
+        case CALLBACK_DISPLAY: return "display";
+        case CALLBACK_UPDATE:  return "update";
+        case CALLBACK_ACTION:  return "action";
+        default:               return "?";
+    }
+}
+
+void Watchdog::clear()
+{
+    total.store(0);
+    next.store(0);
+    for (Slot& slot : log)
+    {
+        slot.sequence.store(0);
+    }
+}
+/* ---------- Watchdog Class Ends ---------- */